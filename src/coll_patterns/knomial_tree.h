@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef KNOMIAL_TREE_H_
+#define KNOMIAL_TREE_H_
+
+/**
+ *  Knomial tree over the virtual ranks: vrank 0 is the root, the parent of
+ *  vrank is obtained by zeroing the lowest non-zero digit of vrank in
+ *  radix-based representation. Children are obtained by setting any of the
+ *  lower (zero) digits.
+ */
+#define KN_TREE_VRANK(_rank, _root, _size)                                     \
+    (((_rank) - (_root) + (_size)) % (_size))
+#define KN_TREE_RANK(_vrank, _root, _size) (((_vrank) + (_root)) % (_size))
+
+/**
+ *  @param [in]  _vrank  Virtual rank
+ *  @param [in]  _radix  Knomial radix
+ *  @param [in]  _size   Team size
+ *  @return radix**L where L is the position of the lowest non-zero digit of
+ *          _vrank, ie the distance to the parent is a multiple of it. For the
+ *          root it is the smallest power of _radix that is >= _size.
+ *          Children of _vrank are _vrank + k * radix**l, 0 < k < _radix,
+ *          radix**l < returned value.
+ */
+static inline int ucc_kn_tree_level(int vrank, int radix, int size)
+{
+    int radix_pow = 1;
+
+    while (radix_pow < size && 0 == vrank % (radix_pow * radix)) {
+        radix_pow *= radix;
+    }
+    return radix_pow;
+}
+
+#define KN_TREE_PARENT(_vrank, _radix, _level)                                 \
+    ((_vrank) - (_vrank) % ((_level) * (_radix)))
+
+#endif
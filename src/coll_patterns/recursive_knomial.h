@@ -62,4 +62,12 @@ enum {
 #define KN_RECURSIVE_GET_PROXY(__myrank, __full_size) (__myrank - __full_size)
 #define KN_RECURSIVE_GET_EXTRA(__myrank, __full_size) (__myrank + __full_size)
 
+/**
+ *  Peer of _myrank at distance _k (0 < _k < _radix) in the group of the
+ *  current step of recursive knomial loop. _radix_pow is radix**iteration.
+ */
+#define KN_RECURSIVE_GET_PEER(__myrank, __k, __radix, __radix_pow)             \
+    ((__myrank + (__k) * (__radix_pow)) % ((__radix_pow) * (__radix)) +       \
+     (__myrank - __myrank % ((__radix_pow) * (__radix))))
+
 #endif
@@ -40,6 +40,13 @@ typedef struct ucc_mc_ops {
     ucc_status_t (*reduce)(const void *src1, const void *src2,
                            void *dst, size_t count, ucc_datatype_t dt,
                            ucc_reduction_op_t op);
+    ucc_status_t (*reduce_multi)(const void *src1, const void *src2,
+                                 void *dst, size_t n_vectors, size_t count,
+                                 size_t stride, ucc_datatype_t dt,
+                                 ucc_reduction_op_t op);
+    ucc_status_t (*memcpy)(void *dst, const void *src, size_t len,
+                           ucc_memory_type_t dst_mem_type,
+                           ucc_memory_type_t src_mem_type);
  } ucc_mc_ops_t;
 
 typedef struct ucc_mc_base {
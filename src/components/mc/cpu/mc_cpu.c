@@ -8,6 +8,7 @@
 #include "mc_cpu_reduce.h"
 #include "utils/ucc_malloc.h"
 #include <sys/types.h>
+#include <string.h>
 
 static ucc_config_field_t ucc_mc_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_mc_cpu_config_t, super),
@@ -35,27 +36,50 @@ static ucc_status_t ucc_mc_cpu_mem_alloc(void **ptr, size_t size)
     return UCC_OK;
 }
 
-static ucc_status_t ucc_mc_cpu_reduce(const void *src1, const void *src2,
-                                      void *dst, size_t count,
-                                      ucc_datatype_t dt, ucc_reduction_op_t op)
+static ucc_status_t ucc_mc_cpu_reduce_multi(const void *src1, const void *src2,
+                                            void *dst, size_t n_vectors,
+                                            size_t count, size_t stride,
+                                            ucc_datatype_t dt,
+                                            ucc_reduction_op_t op)
 {
     switch(dt) {
     case UCC_DT_INT16:
-        DO_DT_REDUCE_INT(int16_t, op, src1, src2, dst, count);
+        DO_DT_REDUCE_INT(int16_t, op, src1, src2, dst, count, n_vectors,
+                         stride);
         break;
     case UCC_DT_INT32:
-        DO_DT_REDUCE_INT(int32_t, op, src1, src2, dst, count);
+        DO_DT_REDUCE_INT(int32_t, op, src1, src2, dst, count, n_vectors,
+                         stride);
         break;
     case UCC_DT_INT64:
-        DO_DT_REDUCE_INT(int64_t, op, src1, src2, dst, count);
+        DO_DT_REDUCE_INT(int64_t, op, src1, src2, dst, count, n_vectors,
+                         stride);
         break;
     case UCC_DT_FLOAT32:
         ucc_assert(4 == sizeof(float));
-        DO_DT_REDUCE_FLOAT(float, op, src1, src2, dst, count);
+        DO_DT_REDUCE_FLOAT(float, op, src1, src2, dst, count, n_vectors,
+                           stride);
         break;
     case UCC_DT_FLOAT64:
         ucc_assert(8 == sizeof(double));
-        DO_DT_REDUCE_FLOAT(double, op, src1, src2, dst, count);
+        DO_DT_REDUCE_FLOAT(double, op, src1, src2, dst, count, n_vectors,
+                           stride);
+        break;
+    case UCC_DT_FLOAT32_INT32:
+        DO_DT_REDUCE_PAIR(ucc_mc_cpu_float_int_t, op, src1, src2, dst, count,
+                          n_vectors, stride);
+        break;
+    case UCC_DT_FLOAT64_INT32:
+        DO_DT_REDUCE_PAIR(ucc_mc_cpu_double_int_t, op, src1, src2, dst, count,
+                          n_vectors, stride);
+        break;
+    case UCC_DT_INT32_INT32:
+        DO_DT_REDUCE_PAIR(ucc_mc_cpu_int_int_t, op, src1, src2, dst, count,
+                          n_vectors, stride);
+        break;
+    case UCC_DT_INT64_INT32:
+        DO_DT_REDUCE_PAIR(ucc_mc_cpu_long_int_t, op, src1, src2, dst, count,
+                          n_vectors, stride);
         break;
     default:
         mc_error(&ucc_mc_cpu.super, "unsupported reduction type (%d)", dt);
@@ -64,6 +88,23 @@ static ucc_status_t ucc_mc_cpu_reduce(const void *src1, const void *src2,
     return 0;
 }
 
+static ucc_status_t ucc_mc_cpu_reduce(const void *src1, const void *src2,
+                                      void *dst, size_t count,
+                                      ucc_datatype_t dt, ucc_reduction_op_t op)
+{
+    return ucc_mc_cpu_reduce_multi(src1, src2, dst, 1, count, 0, dt, op);
+}
+
+static ucc_status_t ucc_mc_cpu_memcpy(void *dst, const void *src, size_t len,
+                                      ucc_memory_type_t dst_mem_type,
+                                      ucc_memory_type_t src_mem_type)
+{
+    ucc_assert((dst_mem_type == UCC_MEMORY_TYPE_HOST) &&
+               (src_mem_type == UCC_MEMORY_TYPE_HOST));
+    memcpy(dst, src, len);
+    return UCC_OK;
+}
+
 static ucc_status_t ucc_mc_cpu_mem_free(void *ptr)
 {
     ucc_free(ptr);
@@ -99,7 +140,9 @@ ucc_mc_cpu_t ucc_mc_cpu = {
     .super.ops.mem_type  = ucc_mc_cpu_mem_type,
     .super.ops.mem_alloc = ucc_mc_cpu_mem_alloc,
     .super.ops.mem_free  = ucc_mc_cpu_mem_free,
-    .super.ops.reduce    = ucc_mc_cpu_reduce,
+    .super.ops.reduce       = ucc_mc_cpu_reduce,
+    .super.ops.reduce_multi = ucc_mc_cpu_reduce_multi,
+    .super.ops.memcpy       = ucc_mc_cpu_memcpy,
 };
 
 UCC_CONFIG_REGISTER_TABLE_ENTRY(&ucc_mc_cpu.super.config_table,
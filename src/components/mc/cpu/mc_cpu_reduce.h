@@ -18,47 +18,92 @@
 #define DO_OP_LXOR(_v1, _v2) ((!_v1) != (!_v2))
 #define DO_OP_BXOR(_v1, _v2) (_v1 ^ _v2)
 
-#define DO_DT_REDUCE_WITH_OP(s1, s2, d, count, OP) do {                        \
-        size_t i;                                                              \
-        for (i=0; i<count; i++) {                                              \
-            d[i] = OP(s1[i], s2[i]);                                           \
+/* Value/index pairs, ties are resolved to the lower index */
+#define DO_OP_MAXLOC(_v1, _v2)                                                 \
+    (((_v1).value > (_v2).value ||                                             \
+      ((_v1).value == (_v2).value && (_v1).index < (_v2).index)) ? (_v1)       \
+                                                                 : (_v2))
+#define DO_OP_MINLOC(_v1, _v2)                                                 \
+    (((_v1).value < (_v2).value ||                                             \
+      ((_v1).value == (_v2).value && (_v1).index < (_v2).index)) ? (_v1)       \
+                                                                 : (_v2))
+
+#define UCC_MC_CPU_PAIR_TYPE(_vtype)                                           \
+    struct {                                                                   \
+        _vtype  value;                                                         \
+        int32_t index;                                                         \
+    }
+
+typedef UCC_MC_CPU_PAIR_TYPE(float)   ucc_mc_cpu_float_int_t;
+typedef UCC_MC_CPU_PAIR_TYPE(double)  ucc_mc_cpu_double_int_t;
+typedef UCC_MC_CPU_PAIR_TYPE(int32_t) ucc_mc_cpu_int_int_t;
+typedef UCC_MC_CPU_PAIR_TYPE(int64_t) ucc_mc_cpu_long_int_t;
+
+/* d = s1 OP s2[0] OP s2[1] ... OP s2[n_vectors - 1], the vectors of s2 are
+   ld elements apart. Every element is reduced over all the vectors at once,
+   so dst is written in a single pass. d may be the same buffer as s1. */
+#define DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld, OP) do {         \
+        size_t i, j;                                                           \
+        if (1 == n_vectors) {                                                  \
+            for (i=0; i<count; i++) {                                          \
+                d[i] = OP(s1[i], s2[i]);                                       \
+            }                                                                  \
+        } else {                                                               \
+            for (i=0; i<count; i++) {                                          \
+                d[i] = OP(s1[i], s2[i]);                                       \
+                for (j=1; j<n_vectors; j++) {                                  \
+                    d[i] = OP(d[i], s2[j * ld + i]);                           \
+                }                                                              \
+            }                                                                  \
         }                                                                      \
     } while(0)
 
-#define DO_DT_REDUCE_INT(type, op, src1_p, src2_p, dest_p, count) do {         \
+#define DO_DT_REDUCE_INT(type, op, src1_p, src2_p, dest_p, count,              \
+                         n_vectors, stride) do {                               \
         const type *s1 = (const type *)src1_p;                                 \
         const type *s2 = (const type *)src2_p;                                 \
         type *d = (type *)dest_p;                                              \
+        size_t ld = (stride) / sizeof(type);                                   \
         switch(op) {                                                           \
         case UCC_OP_MAX:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_MAX);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MAX);                                   \
             break;                                                             \
         case UCC_OP_MIN:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_MIN);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MIN);                                   \
             break;                                                             \
         case UCC_OP_SUM:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_SUM);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_SUM);                                   \
             break;                                                             \
         case UCC_OP_PROD:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_PROD);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_PROD);                                  \
             break;                                                             \
         case UCC_OP_LAND:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_LAND);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_LAND);                                  \
             break;                                                             \
         case UCC_OP_BAND:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_BAND);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_BAND);                                  \
             break;                                                             \
         case UCC_OP_LOR:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_LOR);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_LOR);                                   \
             break;                                                             \
         case UCC_OP_BOR:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_BOR);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_BOR);                                   \
             break;                                                             \
         case UCC_OP_LXOR:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_LXOR);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_LXOR);                                  \
             break;                                                             \
         case UCC_OP_BXOR:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_BXOR);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_BXOR);                                  \
             break;                                                             \
         default:                                                               \
             mc_error(&ucc_mc_cpu.super, "int dtype does not support "          \
@@ -67,22 +112,28 @@
         }                                                                      \
     } while(0)
 
-#define DO_DT_REDUCE_FLOAT(type, op, src1_p, src2_p, dest_p, count) do {       \
+#define DO_DT_REDUCE_FLOAT(type, op, src1_p, src2_p, dest_p, count,            \
+                           n_vectors, stride) do {                             \
         const type *s1 = (const type *)src1_p;                                 \
         const type *s2 = (const type *)src2_p;                                 \
         type *d = (type *)dest_p;                                              \
+        size_t ld = (stride) / sizeof(type);                                   \
         switch(op) {                                                           \
         case UCC_OP_MAX:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_MAX);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MAX);                                   \
             break;                                                             \
         case UCC_OP_MIN:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_MIN);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MIN);                                   \
             break;                                                             \
         case UCC_OP_SUM:                                                       \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_SUM);                 \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_SUM);                                   \
             break;                                                             \
         case UCC_OP_PROD:                                                      \
-            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, DO_OP_PROD);                \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_PROD);                                  \
             break;                                                             \
         default:                                                               \
             mc_error(&ucc_mc_cpu.super, "float dtype does not support "        \
@@ -91,4 +142,26 @@
         }                                                                      \
     } while(0)
 
+#define DO_DT_REDUCE_PAIR(type, op, src1_p, src2_p, dest_p, count,             \
+                          n_vectors, stride) do {                              \
+        const type *s1 = (const type *)src1_p;                                 \
+        const type *s2 = (const type *)src2_p;                                 \
+        type *d = (type *)dest_p;                                              \
+        size_t ld = (stride) / sizeof(type);                                   \
+        switch(op) {                                                           \
+        case UCC_OP_MAXLOC:                                                    \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MAXLOC);                                \
+            break;                                                             \
+        case UCC_OP_MINLOC:                                                    \
+            DO_DT_REDUCE_WITH_OP(s1, s2, d, count, n_vectors, ld,              \
+                                 DO_OP_MINLOC);                                \
+            break;                                                             \
+        default:                                                               \
+            mc_error(&ucc_mc_cpu.super, "pair dtype does not support "         \
+                                        "requested reduce op: %d", op);        \
+            return UCC_ERR_NOT_SUPPORTED;                                      \
+        }                                                                      \
+    } while(0)
+
 #endif
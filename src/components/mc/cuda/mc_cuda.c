@@ -77,6 +77,24 @@ static ucc_status_t ucc_mc_cuda_mem_free(void *ptr)
     return UCC_OK;
 }
 
+static ucc_status_t ucc_mc_cuda_memcpy(void *dst, const void *src, size_t len,
+                                       ucc_memory_type_t dst_mem_type,
+                                       ucc_memory_type_t src_mem_type)
+{
+    cudaError_t st;
+
+    st = cudaMemcpy(dst, src, len, cudaMemcpyDefault);
+    if (st != cudaSuccess) {
+        cudaGetLastError();
+        mc_error(&ucc_mc_cuda.super,
+                 "failed to copy %zd bytes, "
+                 "cuda error %d(%s)",
+                 len, st, cudaGetErrorString(st));
+        return UCC_ERR_NO_MESSAGE;
+    }
+    return UCC_OK;
+}
+
 static ucc_status_t ucc_mc_cuda_mem_type(const void *ptr,
                                          ucc_memory_type_t *mem_type)
 {
@@ -138,6 +156,7 @@ ucc_mc_cuda_t ucc_mc_cuda = {
     .super.ops.mem_alloc = ucc_mc_cuda_mem_alloc,
     .super.ops.mem_free  = ucc_mc_cuda_mem_free,
     .super.ops.reduce    = ucc_mc_cuda_reduce,
+    .super.ops.memcpy    = ucc_mc_cuda_memcpy,
 };
 
 UCC_CONFIG_REGISTER_TABLE_ENTRY(&ucc_mc_cuda.super.config_table,
@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "utils/ucc_coll_utils.h"
+#include "utils/ucc_math.h"
+
+ucc_status_t ucc_tl_ucp_allgather_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             dt_size;
+
+    dt_size = ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (0 == dt_size) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* small blocks are latency bound: log(size) steps algorithms */
+    if (UCC_COLL_ARGS_COUNT(task->args) * dt_size <
+        UCC_TL_UCP_TEAM_CTX(team)->cfg.allgather_ring_thresh) {
+        if (ucc_is_pow2(team->size)) {
+            return ucc_tl_ucp_allgather_rd_init(task);
+        }
+        return ucc_tl_ucp_allgather_bruck_init(task);
+    }
+    return ucc_tl_ucp_allgather_ring_init(task);
+}
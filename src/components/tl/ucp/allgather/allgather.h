@@ -0,0 +1,24 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef ALLGATHER_H_
+#define ALLGATHER_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Allgather: every rank contributes src_counts[0] elements of src_datatype,
+   the contribution of rank r lands at block r of dst_buffer. With
+   UCC_COLL_BUFF_FLAG_IN_PLACE the contribution is taken from its block of
+   dst_buffer. */
+ucc_status_t ucc_tl_ucp_allgather_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allgather_ring_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_init(ucc_tl_ucp_task_t *task);
+
+/* power of two teams only */
+ucc_status_t ucc_tl_ucp_allgather_rd_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Bruck allgather, ceil(log2(size)) steps for any team size. Blocks are
+   kept in scratch in the order relative to the rank: position i holds the
+   block of rank (rank + i) % size. On the step with distance d the first
+   min(d, size - d) positions are sent to rank - d and the same number of
+   blocks from rank + d is appended at position d. In the end scratch is a
+   rotation of dst, so it is copied out in a single pass of two contiguous
+   copies. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP, /* bruck steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allgather_bruck.phase = _phase;                                  \
+        task->allgather_bruck.dist  = dist;                                    \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    ucc_memory_type_t  mem_type   = task->allgather_bruck.mem_type;
+    void              *scratch    = task->allgather_bruck.scratch;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int                dist       = task->allgather_bruck.dist;
+    int                n_blocks;
+    ucc_status_t       status;
+
+    GOTO_PHASE(task->allgather_bruck.phase);
+
+    for (; dist < size; dist *= 2) {
+        n_blocks = ucc_min(dist, size - dist);
+        ucc_tl_ucp_send_nb(scratch, n_blocks * block_size, mem_type,
+                           (rank - dist + size) % size, team, task);
+        ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)scratch + dist * block_size),
+                           n_blocks * block_size, mem_type,
+                           (rank + dist) % size, team, task);
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+    }
+    /* position i goes to block (rank + i) % size */
+    status = ucc_mc_memcpy((void *)((ptrdiff_t)rbuf + rank * block_size),
+                           scratch, (size - rank) * block_size, mem_type,
+                           mem_type);
+    if (UCC_OK == status && rank > 0) {
+        status = ucc_mc_memcpy(
+            rbuf, (void *)((ptrdiff_t)scratch + (size - rank) * block_size),
+            rank * block_size, mem_type, mem_type);
+    }
+    if (UCC_OK != status) {
+        task->super.super.status = status;
+        return status;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+    void              *src;
+
+    task->allgather_bruck.phase = PHASE_INIT;
+    task->allgather_bruck.dist  = 1;
+    task->super.super.status    = UCC_INPROGRESS;
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    src        = UCC_IS_INPLACE(task->args)
+                     ? (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                                team->rank * block_size)
+                     : task->args.buffer_info.src_buffer;
+    status = ucc_mc_memcpy(task->allgather_bruck.scratch, src, block_size,
+                           task->allgather_bruck.mem_type,
+                           task->allgather_bruck.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_allgather_bruck_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_mc_free(task->allgather_bruck.scratch, task->allgather_bruck.mem_type);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team       = task->team;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    ucc_status_t       status;
+
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allgather_bruck.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_mc_alloc(&task->allgather_bruck.scratch,
+                          ucc_max(team->size * block_size, 1),
+                          task->allgather_bruck.mem_type);
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "failed to allocate scratch for allgather");
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_allgather_bruck_start;
+    task->super.progress = ucc_tl_ucp_allgather_bruck_progress;
+    task->super.finalize = ucc_tl_ucp_allgather_bruck_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Recursive doubling allgather for power of two teams. Before the step
+   with distance d rank holds the d contiguous blocks of its group of d
+   ranks, it exchanges them with rank ^ d. Everything happens in dst, no
+   scratch and no final reordering. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP, /* recursive doubling steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allgather_rd.phase = _phase;                                     \
+        task->allgather_rd.dist  = dist;                                       \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_allgather_rd_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    ucc_memory_type_t  mem_type   = task->allgather_rd.mem_type;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int                dist       = task->allgather_rd.dist;
+    int                peer;
+
+    GOTO_PHASE(task->allgather_rd.phase);
+
+    for (; dist < size; dist *= 2) {
+        peer = rank ^ dist;
+        /* groups of dist ranks start at the multiple of dist */
+        ucc_tl_ucp_send_nb(
+            (void *)((ptrdiff_t)rbuf + (rank & ~(dist - 1)) * block_size),
+            dist * block_size, mem_type, peer, team, task);
+        ucc_tl_ucp_recv_nb(
+            (void *)((ptrdiff_t)rbuf + (peer & ~(dist - 1)) * block_size),
+            dist * block_size, mem_type, peer, team, task);
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_rd_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->allgather_rd.phase = PHASE_INIT;
+    task->allgather_rd.dist  = 1;
+    task->super.super.status = UCC_INPROGRESS;
+    if (!UCC_IS_INPLACE(task->args)) {
+        block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                     ucc_dt_size(task->args.buffer_info.src_datatype);
+        status = ucc_mc_memcpy(
+            (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                     team->rank * block_size),
+            task->args.buffer_info.src_buffer, block_size,
+            task->allgather_rd.mem_type, task->allgather_rd.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_allgather_rd_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_rd_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    ucc_assert(ucc_is_pow2(task->team->size));
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allgather_rd.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_allgather_rd_start;
+    task->super.progress = ucc_tl_ucp_allgather_rd_progress;
+    return UCC_OK;
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Ring allgather: on step s rank forwards block (rank - s) to the right
+   neighbor and receives block (rank - s - 1) from the left one. Blocks are
+   sent right from dst and received in place, so there are no extra
+   copies apart from placing the own contribution. */
+enum {
+    PHASE_INIT,
+    PHASE_RING, /* ring steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RING);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allgather_ring.phase = _phase;                                   \
+        task->allgather_ring.step  = step;                                     \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_allgather_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    int                sendto     = (rank + 1) % size;
+    int                recvfrom   = (rank - 1 + size) % size;
+    ucc_memory_type_t  mem_type   = task->allgather_ring.mem_type;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int                step       = task->allgather_ring.step;
+    int                send_block, recv_block;
+
+    GOTO_PHASE(task->allgather_ring.phase);
+
+    for (; step < size - 1; step++) {
+        send_block = (rank - step + size) % size;
+        recv_block = (rank - step - 1 + size) % size;
+        ucc_tl_ucp_send_nb((void *)((ptrdiff_t)rbuf + send_block * block_size),
+                           block_size, mem_type, sendto, team, task);
+        ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)rbuf + recv_block * block_size),
+                           block_size, mem_type, recvfrom, team, task);
+    PHASE_RING:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RING);
+            return UCC_INPROGRESS;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->allgather_ring.phase = PHASE_INIT;
+    task->allgather_ring.step  = 0;
+    task->super.super.status   = UCC_INPROGRESS;
+    if (!UCC_IS_INPLACE(task->args)) {
+        block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                     ucc_dt_size(task->args.buffer_info.src_datatype);
+        status = ucc_mc_memcpy(
+            (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                     team->rank * block_size),
+            task->args.buffer_info.src_buffer, block_size,
+            task->allgather_ring.mem_type, task->allgather_ring.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_allgather_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_ring_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allgather_ring.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_allgather_ring_start;
+    task->super.progress = ucc_tl_ucp_allgather_ring_progress;
+    return UCC_OK;
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "core/ucc_mc.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_allgatherv_copy_own(ucc_tl_ucp_task_t *task,
+                                            ucc_memory_type_t  mem_type)
+{
+    ucc_coll_buffer_info_t *info = &task->args.buffer_info;
+    size_t                  count, displ;
+
+    count = ucc_coll_args_get_count(&task->args, info->src_counts, 0);
+    if (UCC_IS_INPLACE(task->args) || 0 == count) {
+        return UCC_OK;
+    }
+    displ = ucc_coll_args_get_displacement(&task->args,
+                                           info->dst_displacements,
+                                           task->team->rank);
+    return ucc_mc_memcpy((void *)((ptrdiff_t)info->dst_buffer +
+                                  displ * ucc_dt_size(info->dst_datatype)),
+                         info->src_buffer,
+                         count * ucc_dt_size(info->src_datatype), mem_type,
+                         mem_type);
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t      *team  = task->team;
+    ucc_coll_buffer_info_t *info  = &task->args.buffer_info;
+    size_t                  total = 0;
+    int                     i;
+
+    if (0 == ucc_dt_size(info->src_datatype) ||
+        0 == ucc_dt_size(info->dst_datatype)) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    for (i = 0; i < team->size; i++) {
+        total += ucc_coll_args_get_count(&task->args, info->dst_counts, i);
+    }
+    /* small messages are latency bound: 2 * log(size) steps of the tree
+       against size - 1 steps of the ring */
+    if (total * ucc_dt_size(info->dst_datatype) <
+        team->size * UCC_TL_UCP_TEAM_CTX(team)->cfg.allgatherv_ring_thresh) {
+        return ucc_tl_ucp_allgatherv_knomial_init(task);
+    }
+    return ucc_tl_ucp_allgatherv_ring_init(task);
+}
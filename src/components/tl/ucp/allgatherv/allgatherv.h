@@ -0,0 +1,27 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef ALLGATHERV_H_
+#define ALLGATHERV_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Allgatherv: src_counts[0] elements of src_datatype from src_buffer of
+   rank r land at dst_displacements[r] in dst_buffer of every rank,
+   dst_counts[r] must match. Displacements are in elements of
+   dst_datatype. With UCC_COLL_BUFF_FLAG_IN_PLACE own block is already at
+   its place in dst_buffer. */
+ucc_status_t ucc_tl_ucp_allgatherv_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allgatherv_ring_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allgatherv_knomial_init(ucc_tl_ucp_task_t *task);
+
+/* Copies own block of src_buffer to its place in dst_buffer unless the
+   collective is in place */
+ucc_status_t ucc_tl_ucp_allgatherv_copy_own(ucc_tl_ucp_task_t *task,
+                                            ucc_memory_type_t  mem_type);
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial allgatherv: blocks are gathered up the knomial tree rooted at rank
+   0, every rank receiving the blocks of its subtree, then the root and the
+   interior ranks send each child all the blocks outside of its subtree.
+   Every rank has the full dst buffer, so all the data goes straight to
+   the displacements. Only the counts are the same on all ranks, the
+   displacements are not: blocks adjacent in dst of one rank may have gaps
+   between them on another. So the blocks exchanged with a peer go as one
+   message of UCP IOV datatype built from the local displacements on each
+   side, the stream of bytes is the same. */
+enum {
+    PHASE_INIT,
+    PHASE_CHILDREN, /* recv subtrees from the children */
+    PHASE_PARENT,   /* exchange with the parent */
+    PHASE_BCAST,    /* send to the children */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_CHILDREN);                                       \
+            CHECK_PHASE(PHASE_PARENT);                                         \
+            CHECK_PHASE(PHASE_BCAST);                                          \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allgatherv_kn.phase = _phase;                                    \
+    } while (0)
+
+/* Fills iov with the non-empty blocks [first, last) of dst, returns the
+   number of entries */
+static inline int allgatherv_kn_fill_iov(ucc_tl_ucp_task_t *task,
+                                         ucp_dt_iov_t *iov, int first,
+                                         int last)
+{
+    ucc_coll_buffer_info_t *info    = &task->args.buffer_info;
+    size_t                  dt_size = ucc_dt_size(info->dst_datatype);
+    int                     n_iov   = 0;
+    size_t                  count, displ;
+    int                     block;
+
+    for (block = first; block < last; block++) {
+        count = ucc_coll_args_get_count(&task->args, info->dst_counts, block);
+        if (0 == count) {
+            continue;
+        }
+        displ = ucc_coll_args_get_displacement(&task->args,
+                                               info->dst_displacements, block);
+        iov[n_iov].buffer =
+            (void *)((ptrdiff_t)info->dst_buffer + displ * dt_size);
+        iov[n_iov].length = count * dt_size;
+        n_iov++;
+    }
+    return n_iov;
+}
+
+/* Posts one send (or receive) of the blocks [first, last) followed by
+   [first2, last2) to (from) peer. The iov entries are taken from the task
+   and stay in use until the phase completes. */
+static inline void allgatherv_kn_post(ucc_tl_ucp_task_t *task, int first,
+                                      int last, int first2, int last2,
+                                      int peer, int is_send)
+{
+    ucp_dt_iov_t *iov = task->allgatherv_kn.iov + task->allgatherv_kn.n_iov;
+    int           n_iov;
+
+    n_iov = allgatherv_kn_fill_iov(task, iov, first, last);
+    n_iov += allgatherv_kn_fill_iov(task, iov + n_iov, first2, last2);
+    if (0 == n_iov) {
+        return;
+    }
+    if (1 == n_iov) {
+        if (is_send) {
+            ucc_tl_ucp_send_nb(iov[0].buffer, iov[0].length,
+                               task->allgatherv_kn.mem_type, peer, task->team,
+                               task);
+        } else {
+            ucc_tl_ucp_recv_nb(iov[0].buffer, iov[0].length,
+                               task->allgatherv_kn.mem_type, peer, task->team,
+                               task);
+        }
+        return;
+    }
+    task->allgatherv_kn.n_iov += n_iov;
+    if (is_send) {
+        ucc_tl_ucp_send_iov_nb(iov, n_iov, task->allgatherv_kn.mem_type, peer,
+                               task->team, task);
+    } else {
+        ucc_tl_ucp_recv_iov_nb(iov, n_iov, task->allgatherv_kn.mem_type, peer,
+                               task->team, task);
+    }
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                rank  = team->rank;
+    int                size  = team->size;
+    int                radix = task->allgatherv_kn.radix;
+    int                level, radix_pow, k, peer, parent, last;
+
+    level  = ucc_kn_tree_level(rank, radix, size);
+    parent = KN_TREE_PARENT(rank, radix, level);
+    last   = ucc_min(rank + level, size);
+    GOTO_PHASE(task->allgatherv_kn.phase);
+
+    for (radix_pow = 1; radix_pow < level; radix_pow *= radix) {
+        for (k = 1; k < radix; k++) {
+            peer = rank + k * radix_pow;
+            if (peer >= size) {
+                break;
+            }
+            allgatherv_kn_post(task, peer, ucc_min(peer + radix_pow, size),
+                               size, size, peer, 0);
+        }
+    }
+PHASE_CHILDREN:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_CHILDREN);
+        return UCC_INPROGRESS;
+    }
+    task->allgatherv_kn.n_iov = 0;
+    if (rank != 0) {
+        /* own subtree goes up, the rest of the blocks come back */
+        allgatherv_kn_post(task, rank, last, size, size, parent, 1);
+        allgatherv_kn_post(task, 0, rank, last, size, parent, 0);
+    }
+PHASE_PARENT:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_PARENT);
+        return UCC_INPROGRESS;
+    }
+    task->allgatherv_kn.n_iov = 0;
+    for (radix_pow = level / radix; radix_pow > 0; radix_pow /= radix) {
+        for (k = 1; k < radix; k++) {
+            peer = rank + k * radix_pow;
+            if (peer >= size) {
+                break;
+            }
+            allgatherv_kn_post(task, 0, peer,
+                               ucc_min(peer + radix_pow, size), size, peer, 1);
+        }
+    }
+PHASE_BCAST:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_BCAST);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->allgatherv_kn.phase = PHASE_INIT;
+    task->allgatherv_kn.n_iov = 0;
+    task->super.super.status  = UCC_INPROGRESS;
+    status = ucc_tl_ucp_allgatherv_copy_own(task, task->allgatherv_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_allgatherv_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_free(task->allgatherv_kn.iov);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                size       = team->size;
+    int                n_children = 0;
+    int                radix, level, radix_pow, k;
+    size_t             alloc_size;
+    ucc_status_t       status;
+
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allgatherv_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* UCP IOV datatypes are host memory only */
+    if (UCC_MEMORY_TYPE_HOST != task->allgatherv_kn.mem_type) {
+        return ucc_tl_ucp_allgatherv_ring_init(task);
+    }
+    radix = ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.allgatherv_kn_radix, size);
+    if (radix < 2) {
+        radix = 2;
+    }
+    task->allgatherv_kn.radix = radix;
+    /* at most size - 1 blocks go to every child in the last phase, the
+       exchanges of the first two phases take at most size blocks in total */
+    level = ucc_kn_tree_level(team->rank, radix, size);
+    for (radix_pow = 1; radix_pow < level; radix_pow *= radix) {
+        for (k = 1; k < radix && team->rank + k * radix_pow < size; k++) {
+            n_children++;
+        }
+    }
+    alloc_size = ucc_max(n_children, 1) * size * sizeof(ucp_dt_iov_t);
+    task->allgatherv_kn.iov = ucc_malloc(alloc_size, "allgatherv_kn_iov");
+    if (!task->allgatherv_kn.iov) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes for iov",
+                 alloc_size);
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->super.post     = ucc_tl_ucp_allgatherv_knomial_start;
+    task->super.progress = ucc_tl_ucp_allgatherv_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_allgatherv_knomial_finalize;
+    return UCC_OK;
+}
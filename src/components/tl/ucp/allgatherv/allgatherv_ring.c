@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Ring allgatherv: same as the ring allgather, on step s rank forwards block
+   (rank - s) and receives block (rank - s - 1). Blocks are sent from and
+   received to their displacements in dst, empty blocks are skipped. */
+enum {
+    PHASE_INIT,
+    PHASE_RING, /* ring steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RING);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allgatherv_ring.phase = _phase;                                  \
+        task->allgatherv_ring.step  = step;                                    \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_allgatherv_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t      *team     = task->team;
+    ucc_coll_buffer_info_t *info     = &task->args.buffer_info;
+    int                     rank     = team->rank;
+    int                     size     = team->size;
+    int                     sendto   = (rank + 1) % size;
+    int                     recvfrom = (rank - 1 + size) % size;
+    ucc_memory_type_t       mem_type = task->allgatherv_ring.mem_type;
+    size_t                  dt_size  = ucc_dt_size(info->dst_datatype);
+    int                     step     = task->allgatherv_ring.step;
+    int                     block;
+    size_t                  count, displ;
+
+    GOTO_PHASE(task->allgatherv_ring.phase);
+
+    for (; step < size - 1; step++) {
+        block = (rank - step + size) % size;
+        count = ucc_coll_args_get_count(&task->args, info->dst_counts, block);
+        if (count > 0) {
+            displ = ucc_coll_args_get_displacement(
+                &task->args, info->dst_displacements, block);
+            ucc_tl_ucp_send_nb(
+                (void *)((ptrdiff_t)info->dst_buffer + displ * dt_size),
+                count * dt_size, mem_type, sendto, team, task);
+        }
+        block = (rank - step - 1 + size) % size;
+        count = ucc_coll_args_get_count(&task->args, info->dst_counts, block);
+        if (count > 0) {
+            displ = ucc_coll_args_get_displacement(
+                &task->args, info->dst_displacements, block);
+            ucc_tl_ucp_recv_nb(
+                (void *)((ptrdiff_t)info->dst_buffer + displ * dt_size),
+                count * dt_size, mem_type, recvfrom, team, task);
+        }
+    PHASE_RING:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RING);
+            return UCC_INPROGRESS;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->allgatherv_ring.phase = PHASE_INIT;
+    task->allgatherv_ring.step  = 0;
+    task->super.super.status    = UCC_INPROGRESS;
+    status = ucc_tl_ucp_allgatherv_copy_own(task,
+                                            task->allgatherv_ring.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_allgatherv_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allgatherv_ring_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allgatherv_ring.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_allgatherv_ring_start;
+    task->super.progress = ucc_tl_ucp_allgatherv_ring_progress;
+    return UCC_OK;
+}
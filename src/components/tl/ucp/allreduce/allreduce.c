@@ -0,0 +1,38 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_allreduce_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t           *team = task->team;
+    ucc_tl_ucp_context_config_t *cfg  = &UCC_TL_UCP_TEAM_CTX(team)->cfg;
+    size_t                       count, msgsize;
+
+    if ((task->args.mask & UCC_COLL_ARG_FIELD_USERDEFINED_REDUCTIONS) ||
+        (0 == ucc_dt_size(task->args.buffer_info.src_datatype))) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined reductions/datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    count   = UCC_COLL_ARGS_COUNT(task->args);
+    msgsize = count * ucc_dt_size(task->args.buffer_info.src_datatype);
+    /* Ring and SRA split the vector between ranks, so they require at
+       least one element per rank to be of any use */
+    if (count >= team->size && msgsize >= cfg->allreduce_ring_thresh) {
+        return ucc_tl_ucp_allreduce_ring_init(task);
+    }
+    if (team->size >= cfg->allreduce_dbt_min_team_size &&
+        msgsize >= cfg->allreduce_dbt_thresh) {
+        return ucc_tl_ucp_allreduce_dbt_init(task);
+    }
+    if (count >= team->size && msgsize >= cfg->allreduce_sra_kn_thresh) {
+        return ucc_tl_ucp_allreduce_sra_knomial_init(task);
+    }
+    return ucc_tl_ucp_allreduce_knomial_init(task);
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef ALLREDUCE_H_
+#define ALLREDUCE_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+ucc_status_t ucc_tl_ucp_allreduce_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_finalize(ucc_coll_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,442 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Double binary tree allreduce: the vector is split in two halves, each
+   half is reduced to the root and broadcast back over its own binary tree.
+   The second tree is built so that the leaves of the first one (odd ranks)
+   are its interior nodes, hence every rank sends and receives about the
+   same amount of data. Both halves are pipelined in fragments of
+   frag_count elements with at most max_inflight fragments in flight per
+   tree.
+   Each tree uses its own tag: the same pair of ranks may be connected in
+   both trees and the order of the messages of different trees between
+   them is not defined. */
+enum {
+    PHASE_INIT,
+    PHASE_TREES, /* pipelined reduce + bcast over both trees */
+    PHASE_FLUSH, /* wait for the last sends */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_TREES);                                          \
+            CHECK_PHASE(PHASE_FLUSH);                                          \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allreduce_dbt.phase = _phase;                                    \
+    } while (0)
+
+#define DBT_N_TREES 2
+
+typedef struct ucc_tl_ucp_allreduce_dbt_tree {
+    uint32_t                         tag;
+    int                              parent;
+    int                              children[2];
+    int                              n_children;
+    size_t                           offset; /* tree half of the vector */
+    size_t                           len;
+    int                              n_frags;
+    int                              reduce_posted;
+    int                              reduce_done;
+    int                              bcast_posted;
+    int                              bcast_done;
+    ucc_tl_ucp_frag_slot_t          *reduce_slots;
+    ucc_tl_ucp_frag_slot_t          *bcast_slots;
+} ucc_tl_ucp_allreduce_dbt_tree_t;
+
+/* In-order binary tree over positions 0..size-1 (position 0 is the root
+   having single child). Parent of the position is obtained by clearing its
+   lowest set bit or by setting the next one, whichever fits the tree. */
+static inline int dbt_parent(int pos, int size)
+{
+    int bit, up;
+
+    if (0 == pos) {
+        return -1;
+    }
+    bit = pos & (-pos);
+    up  = (pos ^ bit) | (bit << 1);
+    return (up < size) ? up : (pos ^ bit);
+}
+
+static inline void dbt_children(int pos, int size, int *children,
+                                int *n_children)
+{
+    int lowbit = pos ? (pos & (-pos)) : size;
+    int bit, c;
+
+    *n_children = 0;
+    for (bit = 1; bit < lowbit; bit <<= 1) {
+        c = pos - bit;
+        if (c > 0 && dbt_parent(c, size) == pos) {
+            children[(*n_children)++] = c;
+        }
+        c = pos + bit;
+        if (c < size && dbt_parent(c, size) == pos) {
+            children[(*n_children)++] = c;
+        }
+    }
+    ucc_assert(*n_children <= 2);
+}
+
+/* The second tree is the first one either mirrored (even size) or shifted
+   by one position (odd size): both flip the parity of the position, so odd
+   ranks, which are the leaves of the first tree, become interior nodes.
+   The mirror of an odd size keeps the parity, so it is not used there. */
+static inline int dbt_rank_to_pos(int rank, int size, int tree)
+{
+    if (0 == tree) {
+        return rank;
+    }
+    return (size % 2) ? ((rank - 1 + size) % size) : (size - 1 - rank);
+}
+
+static inline int dbt_pos_to_rank(int pos, int size, int tree)
+{
+    if (0 == tree) {
+        return pos;
+    }
+    return (size % 2) ? ((pos + 1) % size) : (size - 1 - pos);
+}
+
+/* Offset and length (in elements) of the fragment of the tree half */
+static inline void dbt_frag(ucc_tl_ucp_allreduce_dbt_tree_t *tree, int frag,
+                            size_t frag_count, size_t *offset, size_t *len)
+{
+    *offset = tree->offset + frag * frag_count;
+    *len    = ucc_min(frag_count, tree->offset + tree->len - *offset);
+}
+
+/* Scratch space for the fragment received from the child k of the tree t */
+static inline void *dbt_scratch(ucc_tl_ucp_task_t *task, int t, int frag,
+                                int k)
+{
+    int    max_inflight = task->allreduce_dbt.max_inflight;
+    size_t frag_size    = task->allreduce_dbt.frag_count *
+                       ucc_dt_size(task->args.buffer_info.src_datatype);
+
+    return (void *)((ptrdiff_t)task->allreduce_dbt.scratch +
+                    ((t * max_inflight + frag % max_inflight) * 2 + k) *
+                        frag_size);
+}
+
+/* Progresses single tree: posts the receives within the pipeline window,
+   reduces the fragments completed by the children and forwards them up,
+   forwards the broadcast fragments down. "progressed" is set if any
+   fragment moved forward. */
+static ucc_status_t dbt_tree_progress(ucc_tl_ucp_task_t *task, int t,
+                                      int *progressed)
+{
+    ucc_tl_ucp_allreduce_dbt_tree_t *tree = &task->allreduce_dbt.trees[t];
+    ucc_tl_ucp_team_t  *team         = task->team;
+    ucc_memory_type_t   mem_type     = task->allreduce_dbt.mem_type;
+    ucc_datatype_t      dt           = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t  op           = task->args.reduce.predefined_op;
+    size_t              dt_size      = ucc_dt_size(dt);
+    size_t              frag_count   = task->allreduce_dbt.frag_count;
+    int                 max_inflight = task->allreduce_dbt.max_inflight;
+    void               *rbuf         = task->args.buffer_info.dst_buffer;
+    void               *sbuf         = UCC_IS_INPLACE(task->args)
+                                           ? rbuf
+                                           : task->args.buffer_info.src_buffer;
+    ucc_tl_ucp_frag_slot_t *slot;
+    size_t       offset, len;
+    int          frag, k;
+    ucc_status_t status;
+    void        *src;
+
+    /* p2p helpers take the tag from the task */
+    task->tag = tree->tag;
+    while (tree->reduce_posted < tree->n_frags &&
+           tree->reduce_posted < tree->reduce_done + max_inflight) {
+        frag = tree->reduce_posted;
+        slot = &tree->reduce_slots[frag % max_inflight];
+        slot->completed = 0;
+        dbt_frag(tree, frag, frag_count, &offset, &len);
+        for (k = 0; k < tree->n_children; k++) {
+            status = ucc_tl_ucp_recv_frag_nb(dbt_scratch(task, t, frag, k),
+                                             len * dt_size, mem_type,
+                                             tree->children[k], team, task,
+                                             slot);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        tree->reduce_posted++;
+    }
+
+    while (tree->reduce_done < tree->reduce_posted &&
+           tree->reduce_slots[tree->reduce_done % max_inflight].completed ==
+               tree->n_children) {
+        frag = tree->reduce_done;
+        dbt_frag(tree, frag, frag_count, &offset, &len);
+        src = (void *)((ptrdiff_t)sbuf + offset * dt_size);
+        for (k = 0; k < tree->n_children; k++) {
+            status = ucc_mc_reduce(
+                (0 == k) ? src : (void *)((ptrdiff_t)rbuf + offset * dt_size),
+                dbt_scratch(task, t, frag, k),
+                (void *)((ptrdiff_t)rbuf + offset * dt_size), len, dt,
+                mem_type, op);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce fragment");
+                return status;
+            }
+        }
+        if (tree->n_children > 0) {
+            src = (void *)((ptrdiff_t)rbuf + offset * dt_size);
+        }
+        if (tree->parent >= 0) {
+            /* leaf sends its own data right from the source buffer */
+            ucc_tl_ucp_send_nb(src, len * dt_size, mem_type, tree->parent,
+                               team, task);
+        } else {
+            /* root: the fragment is fully reduced, start its broadcast */
+            for (k = 0; k < tree->n_children; k++) {
+                ucc_tl_ucp_send_nb(src, len * dt_size, mem_type,
+                                   tree->children[k], team, task);
+            }
+            tree->bcast_done++;
+        }
+        tree->reduce_done++;
+        *progressed = 1;
+    }
+
+    if (tree->parent < 0) {
+        return UCC_OK;
+    }
+
+    /* Broadcast fragment overwrites the fragment sent to the parent,
+       it can't arrive before the parent got the reduced one */
+    while (tree->bcast_posted < tree->n_frags &&
+           tree->bcast_posted < tree->bcast_done + max_inflight) {
+        frag = tree->bcast_posted;
+        slot = &tree->bcast_slots[frag % max_inflight];
+        slot->completed = 0;
+        dbt_frag(tree, frag, frag_count, &offset, &len);
+        status = ucc_tl_ucp_recv_frag_nb(
+            (void *)((ptrdiff_t)rbuf + offset * dt_size), len * dt_size,
+            mem_type, tree->parent, team, task, slot);
+        if (UCC_OK != status) {
+            return status;
+        }
+        tree->bcast_posted++;
+    }
+
+    while (tree->bcast_done < tree->bcast_posted &&
+           tree->bcast_slots[tree->bcast_done % max_inflight].completed) {
+        frag = tree->bcast_done;
+        dbt_frag(tree, frag, frag_count, &offset, &len);
+        for (k = 0; k < tree->n_children; k++) {
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)rbuf + offset * dt_size),
+                               len * dt_size, mem_type, tree->children[k],
+                               team, task);
+        }
+        tree->bcast_done++;
+        *progressed = 1;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_allreduce_dbt_tree_t *trees = task->allreduce_dbt.trees;
+    int          polls = 0;
+    int          t, progressed;
+    ucc_status_t status;
+
+    GOTO_PHASE(task->allreduce_dbt.phase);
+
+PHASE_TREES:
+    while (trees[0].bcast_done < trees[0].n_frags ||
+           trees[1].bcast_done < trees[1].n_frags) {
+        progressed = 0;
+        for (t = 0; t < DBT_N_TREES; t++) {
+            status = dbt_tree_progress(task, t, &progressed);
+            if (UCC_OK != status) {
+                task->super.super.status = status;
+                return status;
+            }
+        }
+        if (progressed) {
+            continue;
+        }
+        if (polls++ >= task->n_polls) {
+            SAVE_STATE(PHASE_TREES);
+            return UCC_INPROGRESS;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(task->team)->ucp_worker);
+    }
+
+PHASE_FLUSH:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_FLUSH);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+    int                t;
+
+    task->allreduce_dbt.phase = PHASE_INIT;
+    task->super.super.status  = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            data_size = task->allreduce_dbt.count *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   data_size, task->allreduce_dbt.mem_type,
+                                   task->allreduce_dbt.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    for (t = 0; t < DBT_N_TREES; t++) {
+        task->allreduce_dbt.trees[t].reduce_posted = 0;
+        task->allreduce_dbt.trees[t].reduce_done   = 0;
+        task->allreduce_dbt.trees[t].bcast_posted  = 0;
+        task->allreduce_dbt.trees[t].bcast_done    = 0;
+    }
+    status = ucc_tl_ucp_allreduce_dbt_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->allreduce_dbt.scratch) {
+        ucc_mc_free(task->allreduce_dbt.scratch, task->allreduce_dbt.mem_type);
+    }
+    ucc_free(task->allreduce_dbt.trees);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t    *team = task->team;
+    ucc_tl_ucp_context_t *ctx  = UCC_TL_UCP_TEAM_CTX(team);
+    size_t                dt_size =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+    ucc_tl_ucp_allreduce_dbt_tree_t *tree;
+    ucc_tl_ucp_frag_slot_t *slots;
+    size_t       alloc_size;
+    int          t, k, i, pos, max_inflight;
+    ucc_status_t status;
+
+    task->allreduce_dbt.count   = UCC_COLL_ARGS_COUNT(task->args);
+    task->allreduce_dbt.scratch = NULL;
+    task->allreduce_dbt.trees   = NULL;
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allreduce_dbt.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    if (team->size < 2) {
+        goto out;
+    }
+    max_inflight = ucc_max(ctx->cfg.allreduce_dbt_n_frags, 1);
+    task->allreduce_dbt.max_inflight = max_inflight;
+    task->allreduce_dbt.frag_count =
+        ucc_max(ucc_min(ctx->cfg.allreduce_dbt_frag_size / dt_size,
+                        ucc_buffer_block_count(task->allreduce_dbt.count,
+                                               DBT_N_TREES, 0)), 1);
+
+    alloc_size = DBT_N_TREES * (sizeof(ucc_tl_ucp_allreduce_dbt_tree_t) +
+                                2 * max_inflight *
+                                    sizeof(ucc_tl_ucp_frag_slot_t));
+    task->allreduce_dbt.trees = ucc_malloc(alloc_size, "allreduce_dbt_trees");
+    if (!task->allreduce_dbt.trees) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "failed to allocate %zd bytes for dbt trees", alloc_size);
+        return UCC_ERR_NO_MEMORY;
+    }
+    slots = (ucc_tl_ucp_frag_slot_t *)(task->allreduce_dbt.trees +
+                                                 DBT_N_TREES);
+    for (i = 0; i < DBT_N_TREES * 2 * max_inflight; i++) {
+        slots[i].task      = task;
+        slots[i].completed = 0;
+    }
+    for (t = 0; t < DBT_N_TREES; t++) {
+        tree = &task->allreduce_dbt.trees[t];
+        /* second tree needs a separate tag, it is taken from the team
+           sequence the same way as the task one */
+        tree->tag          = (0 == t) ? task->tag : team->seq_num++;
+        tree->reduce_slots = slots + t * 2 * max_inflight;
+        tree->bcast_slots  = tree->reduce_slots + max_inflight;
+        tree->offset =
+            ucc_buffer_block_offset(task->allreduce_dbt.count, DBT_N_TREES, t);
+        tree->len =
+            ucc_buffer_block_count(task->allreduce_dbt.count, DBT_N_TREES, t);
+        tree->n_frags = (tree->len + task->allreduce_dbt.frag_count - 1) /
+                        task->allreduce_dbt.frag_count;
+        pos          = dbt_rank_to_pos(team->rank, team->size, t);
+        tree->parent = dbt_parent(pos, team->size);
+        if (tree->parent >= 0) {
+            tree->parent = dbt_pos_to_rank(tree->parent, team->size, t);
+        }
+        dbt_children(pos, team->size, tree->children, &tree->n_children);
+        for (k = 0; k < tree->n_children; k++) {
+            tree->children[k] =
+                dbt_pos_to_rank(tree->children[k], team->size, t);
+        }
+    }
+    if (task->allreduce_dbt.count > 0) {
+        status = ucc_mc_alloc(&task->allreduce_dbt.scratch,
+                              DBT_N_TREES * max_inflight * 2 *
+                                  task->allreduce_dbt.frag_count * dt_size,
+                              task->allreduce_dbt.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for allreduce");
+            ucc_free(task->allreduce_dbt.trees);
+            return status;
+        }
+    }
+out:
+    task->super.post     = ucc_tl_ucp_allreduce_dbt_start;
+    task->super.progress = ucc_tl_ucp_allreduce_dbt_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_dbt_finalize;
+    return UCC_OK;
+}
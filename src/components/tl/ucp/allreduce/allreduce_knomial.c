@@ -0,0 +1,254 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/recursive_knomial.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+enum {
+    PHASE_INIT,
+    PHASE_LOOP,  /* main loop of recursive k-ing */
+    PHASE_EXTRA, /* recv from extra rank */
+    PHASE_PROXY, /* send from proxy to extra rank */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_EXTRA);                                          \
+            CHECK_PHASE(PHASE_PROXY);                                          \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define RESTORE_STATE()                                                        \
+    do {                                                                       \
+        iteration = task->allreduce_kn.iteration;                              \
+        radix_pow = task->allreduce_kn.radix_mask_pow;                         \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allreduce_kn.phase          = _phase;                            \
+        task->allreduce_kn.iteration      = iteration;                         \
+        task->allreduce_kn.radix_mask_pow = radix_pow;                         \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                myrank     = team->rank;
+    int                group_size = team->size;
+    int                radix      = task->allreduce_kn.radix;
+    size_t             count      = task->allreduce_kn.count;
+    ucc_memory_type_t  mem_type   = task->allreduce_kn.mem_type;
+    ucc_datatype_t     dt         = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op         = task->args.reduce.predefined_op;
+    size_t             data_size  = count * ucc_dt_size(dt);
+    void              *scratch    = task->allreduce_kn.scratch;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    void              *sbuf       =
+        UCC_IS_INPLACE(task->args) ? rbuf : task->args.buffer_info.src_buffer;
+    int full_tree_size, pow_k_sup, n_full_subtrees, full_size, node_type;
+    int iteration, radix_pow, k, step_size, peer, n_recv;
+    ucc_status_t status;
+    void        *src;
+
+    KN_RECURSIVE_SETUP(radix, myrank, group_size, pow_k_sup, full_tree_size,
+                       n_full_subtrees, full_size, node_type);
+    RESTORE_STATE();
+    GOTO_PHASE(task->allreduce_kn.phase);
+
+    if (KN_NODE_EXTRA == node_type) {
+        peer = KN_RECURSIVE_GET_PROXY(myrank, full_size);
+        ucc_tl_ucp_send_nb(sbuf, data_size, mem_type, peer, team, task);
+        ucc_tl_ucp_recv_nb(rbuf, data_size, mem_type, peer, team, task);
+    }
+
+    if (KN_NODE_PROXY == node_type) {
+        peer = KN_RECURSIVE_GET_EXTRA(myrank, full_size);
+        ucc_tl_ucp_recv_nb(scratch, data_size, mem_type, peer, team, task);
+    }
+PHASE_EXTRA:
+    if (KN_NODE_PROXY == node_type || KN_NODE_EXTRA == node_type) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_EXTRA);
+            return UCC_INPROGRESS;
+        }
+        if (KN_NODE_EXTRA == node_type) {
+            goto completion;
+        }
+        status = ucc_mc_reduce(sbuf, scratch, rbuf, count, dt, mem_type, op);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce extra data");
+            task->super.super.status = status;
+            return status;
+        }
+    }
+
+    for (; iteration < pow_k_sup; iteration++) {
+        /* On the very first step BASE rank sends its original data,
+           afterwards the partial result accumulated in rbuf is sent */
+        src       = (0 == iteration && KN_NODE_BASE == node_type) ? sbuf : rbuf;
+        step_size = radix_pow * radix;
+        for (k = 1; k < radix; k++) {
+            peer = (myrank + k * radix_pow) % step_size +
+                   (myrank - myrank % step_size);
+            if (peer >= full_size)
+                continue;
+            ucc_tl_ucp_send_nb(src, data_size, mem_type, peer, team, task);
+        }
+
+        n_recv = 0;
+        for (k = 1; k < radix; k++) {
+            peer = (myrank + k * radix_pow) % step_size +
+                   (myrank - myrank % step_size);
+            if (peer >= full_size)
+                continue;
+            ucc_tl_ucp_recv_nb(
+                (void *)((ptrdiff_t)scratch + n_recv * data_size), data_size,
+                mem_type, peer, team, task);
+            n_recv++;
+        }
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+        src       = (0 == iteration && KN_NODE_BASE == node_type) ? sbuf : rbuf;
+        step_size = radix_pow * radix;
+        n_recv    = 0;
+        for (k = 1; k < radix; k++) {
+            peer = (myrank + k * radix_pow) % step_size +
+                   (myrank - myrank % step_size);
+            if (peer >= full_size)
+                continue;
+            status = ucc_mc_reduce(
+                (n_recv == 0) ? src : rbuf,
+                (void *)((ptrdiff_t)scratch + n_recv * data_size), rbuf, count,
+                dt, mem_type, op);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce step data");
+                task->super.super.status = status;
+                return status;
+            }
+            n_recv++;
+        }
+        radix_pow *= radix;
+    }
+    if (KN_NODE_PROXY == node_type) {
+        peer = KN_RECURSIVE_GET_EXTRA(myrank, full_size);
+        ucc_tl_ucp_send_nb(rbuf, data_size, mem_type, peer, team, task);
+        goto PHASE_PROXY;
+    } else {
+        goto completion;
+    }
+
+PHASE_PROXY:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_PROXY);
+        return UCC_INPROGRESS;
+    }
+
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->allreduce_kn.phase          = PHASE_INIT;
+    task->allreduce_kn.iteration      = 0;
+    task->allreduce_kn.radix_mask_pow = 1;
+    task->super.super.status          = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            data_size = task->allreduce_kn.count *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   data_size, task->allreduce_kn.mem_type,
+                                   task->allreduce_kn.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_allreduce_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->allreduce_kn.scratch) {
+        ucc_mc_free(task->allreduce_kn.scratch, task->allreduce_kn.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->allreduce_kn.count   = UCC_COLL_ARGS_COUNT(task->args);
+    task->allreduce_kn.scratch = NULL;
+    task->allreduce_kn.radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.allreduce_kn_radix, team->size);
+    if (task->allreduce_kn.radix < 2) {
+        task->allreduce_kn.radix = 2;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allreduce_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    data_size = task->allreduce_kn.count *
+                ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->size > 1 && data_size > 0) {
+        status = ucc_mc_alloc(&task->allreduce_kn.scratch,
+                              (task->allreduce_kn.radix - 1) * data_size,
+                              task->allreduce_kn.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for allreduce");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_allreduce_knomial_start;
+    task->super.progress = ucc_tl_ucp_allreduce_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_knomial_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,306 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Pipelined ring allreduce: reduce-scatter ring followed by allgather ring,
+   2 * (size - 1) steps in total. The block of every step is split into
+   n_frags fragments and the resulting sequence of (step, fragment)
+   operations is pipelined: up to max_inflight fragments are being received
+   while the previous ones are reduced and forwarded. Both neighbors post
+   the operations in the same order, so a single task tag is enough. */
+enum {
+    PHASE_INIT,
+    PHASE_RING,  /* pipelined ring steps */
+    PHASE_FLUSH, /* wait for the last sends */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RING);                                           \
+            CHECK_PHASE(PHASE_FLUSH);                                          \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allreduce_ring.phase = _phase;                                   \
+    } while (0)
+
+/* Computes the block sent and received on the ring step "step".
+   Reduce-scatter steps go first, then the allgather ones. */
+static inline void ring_step_blocks(int rank, int size, int step,
+                                    int *send_block, int *recv_block)
+{
+    if (step < size - 1) {
+        *send_block = (rank - step + size) % size;
+        *recv_block = (rank - step - 1 + 2 * size) % size;
+    } else {
+        step       -= size - 1;
+        *send_block = (rank - step + 1 + size) % size;
+        *recv_block = (rank - step + size) % size;
+    }
+}
+
+/* Offset and length (in elements) of fragment "frag" of block "block" */
+static inline void ring_frag(size_t count, int size, int n_frags, int block,
+                             int frag, size_t *offset, size_t *len)
+{
+    size_t block_len = ucc_buffer_block_count(count, size, block);
+
+    *offset = ucc_buffer_block_offset(count, size, block) +
+              ucc_buffer_block_offset(block_len, n_frags, frag);
+    *len    = ucc_buffer_block_count(block_len, n_frags, frag);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team         = task->team;
+    int                rank         = team->rank;
+    int                size         = team->size;
+    int                sendto       = (rank + 1) % size;
+    int                recvfrom     = (rank - 1 + size) % size;
+    size_t             count        = task->allreduce_ring.count;
+    ucc_memory_type_t  mem_type     = task->allreduce_ring.mem_type;
+    ucc_datatype_t     dt           = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op           = task->args.reduce.predefined_op;
+    size_t             dt_size      = ucc_dt_size(dt);
+    int                n_frags      = task->allreduce_ring.n_frags;
+    int                max_inflight = task->allreduce_ring.max_inflight;
+    int                n_ops        = task->allreduce_ring.n_ops;
+    void              *rbuf         = task->args.buffer_info.dst_buffer;
+    void              *sbuf         = UCC_IS_INPLACE(task->args)
+                                          ? rbuf
+                                          : task->args.buffer_info.src_buffer;
+    ucc_tl_ucp_frag_slot_t *frag;
+    int          polls = 0;
+    int          op_id, step, send_block, recv_block;
+    size_t       offset, len;
+    ucc_status_t status;
+    void        *scratch, *src, *dst;
+
+    GOTO_PHASE(task->allreduce_ring.phase);
+
+PHASE_RING:
+    while (task->allreduce_ring.processed < n_ops ||
+           task->allreduce_ring.sends_posted < n_ops) {
+        while (task->allreduce_ring.recvs_posted < n_ops &&
+               task->allreduce_ring.recvs_posted <
+                   task->allreduce_ring.processed + max_inflight) {
+            op_id = task->allreduce_ring.recvs_posted;
+            step  = op_id / n_frags;
+            frag  = &task->allreduce_ring.frags[op_id % max_inflight];
+            ring_step_blocks(rank, size, step, &send_block, &recv_block);
+            ring_frag(count, size, n_frags, recv_block, op_id % n_frags,
+                      &offset, &len);
+            /* reduce-scatter data goes to scratch to be reduced with the
+               local contribution, allgather data lands in dst directly */
+            dst = (step < size - 1)
+                      ? (void *)((ptrdiff_t)task->allreduce_ring.scratch +
+                                 (op_id % max_inflight) *
+                                     task->allreduce_ring.frag_count * dt_size)
+                      : (void *)((ptrdiff_t)rbuf + offset * dt_size);
+            frag->completed = 0;
+            status = ucc_tl_ucp_recv_frag_nb(dst, len * dt_size, mem_type,
+                                             recvfrom, team, task, frag);
+            if (UCC_OK != status) {
+                task->super.super.status = status;
+                return status;
+            }
+            task->allreduce_ring.recvs_posted++;
+        }
+
+        /* Send of step "s" forwards the block received on step "s - 1",
+           so it can't go ahead of the processed fragments by more than
+           one step */
+        while (task->allreduce_ring.sends_posted < n_ops &&
+               task->allreduce_ring.sends_posted <
+                   task->allreduce_ring.processed + n_frags &&
+               task->send_posted - task->send_completed < max_inflight) {
+            op_id = task->allreduce_ring.sends_posted;
+            step  = op_id / n_frags;
+            ring_step_blocks(rank, size, step, &send_block, &recv_block);
+            ring_frag(count, size, n_frags, send_block, op_id % n_frags,
+                      &offset, &len);
+            src = (0 == step) ? sbuf : rbuf;
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)src + offset * dt_size),
+                               len * dt_size, mem_type, sendto, team, task);
+            task->allreduce_ring.sends_posted++;
+        }
+
+        op_id = task->allreduce_ring.processed;
+        if (op_id < n_ops &&
+            task->allreduce_ring.frags[op_id % max_inflight].completed) {
+            step = op_id / n_frags;
+            if (step < size - 1) {
+                ring_step_blocks(rank, size, step, &send_block, &recv_block);
+                ring_frag(count, size, n_frags, recv_block, op_id % n_frags,
+                          &offset, &len);
+                scratch = (void *)((ptrdiff_t)task->allreduce_ring.scratch +
+                                   (op_id % max_inflight) *
+                                       task->allreduce_ring.frag_count *
+                                       dt_size);
+                status = ucc_mc_reduce(
+                    (void *)((ptrdiff_t)sbuf + offset * dt_size), scratch,
+                    (void *)((ptrdiff_t)rbuf + offset * dt_size), len, dt,
+                    mem_type, op);
+                if (UCC_OK != status) {
+                    tl_error(UCC_TL_TEAM_LIB(team),
+                             "failed to reduce ring fragment");
+                    task->super.super.status = status;
+                    return status;
+                }
+            }
+            task->allreduce_ring.processed++;
+            continue;
+        }
+        if (polls++ >= task->n_polls) {
+            SAVE_STATE(PHASE_RING);
+            return UCC_INPROGRESS;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+    }
+
+PHASE_FLUSH:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_FLUSH);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->allreduce_ring.phase        = PHASE_INIT;
+    task->allreduce_ring.recvs_posted = 0;
+    task->allreduce_ring.sends_posted = 0;
+    task->allreduce_ring.processed    = 0;
+    task->super.super.status          = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            data_size = task->allreduce_ring.count *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   data_size, task->allreduce_ring.mem_type,
+                                   task->allreduce_ring.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_allreduce_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->allreduce_ring.scratch) {
+        ucc_mc_free(task->allreduce_ring.scratch,
+                    task->allreduce_ring.mem_type);
+    }
+    ucc_free(task->allreduce_ring.frags);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t    *team = task->team;
+    ucc_tl_ucp_context_t *ctx  = UCC_TL_UCP_TEAM_CTX(team);
+    size_t                dt_size =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+    size_t       max_block, frag_elems;
+    ucc_status_t status;
+    int          i;
+
+    task->allreduce_ring.count   = UCC_COLL_ARGS_COUNT(task->args);
+    task->allreduce_ring.scratch = NULL;
+    task->allreduce_ring.frags   = NULL;
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allreduce_ring.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    max_block  = ucc_buffer_block_count(task->allreduce_ring.count,
+                                        team->size, 0);
+    frag_elems = ucc_max(ctx->cfg.allreduce_ring_frag_size / dt_size, 1);
+    task->allreduce_ring.n_frags =
+        ucc_max((max_block + frag_elems - 1) / frag_elems, 1);
+    task->allreduce_ring.frag_count =
+        ucc_buffer_block_count(max_block, task->allreduce_ring.n_frags, 0);
+    task->allreduce_ring.max_inflight =
+        ucc_max(ctx->cfg.allreduce_ring_n_frags, 1);
+    task->allreduce_ring.n_ops =
+        2 * (team->size - 1) * task->allreduce_ring.n_frags;
+
+    if (team->size > 1) {
+        task->allreduce_ring.frags =
+            ucc_malloc(task->allreduce_ring.max_inflight *
+                           sizeof(ucc_tl_ucp_frag_slot_t),
+                       "allreduce_ring_frags");
+        if (!task->allreduce_ring.frags) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate %zd bytes for ring fragments",
+                     task->allreduce_ring.max_inflight *
+                         sizeof(ucc_tl_ucp_frag_slot_t));
+            return UCC_ERR_NO_MEMORY;
+        }
+        for (i = 0; i < task->allreduce_ring.max_inflight; i++) {
+            task->allreduce_ring.frags[i].task      = task;
+            task->allreduce_ring.frags[i].completed = 0;
+        }
+        if (task->allreduce_ring.frag_count > 0) {
+            status = ucc_mc_alloc(&task->allreduce_ring.scratch,
+                                  task->allreduce_ring.max_inflight *
+                                      task->allreduce_ring.frag_count *
+                                      dt_size,
+                                  task->allreduce_ring.mem_type);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team),
+                         "failed to allocate scratch for allreduce");
+                ucc_free(task->allreduce_ring.frags);
+                return status;
+            }
+        }
+    }
+    task->super.post     = ucc_tl_ucp_allreduce_ring_start;
+    task->super.progress = ucc_tl_ucp_allreduce_ring_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_ring_finalize;
+    return UCC_OK;
+}
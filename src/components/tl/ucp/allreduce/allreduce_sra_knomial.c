@@ -0,0 +1,373 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/recursive_knomial.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Scatter-Reduce-Allgather knomial allreduce (Rabenseifner's algorithm
+   generalized to arbitrary radix). Reduce-scatter part: on each step the
+   current segment is split into as many blocks as there are ranks in the
+   group, every rank sends away the blocks of its peers and reduces the
+   received pieces of its own block. Allgather part replays the steps in
+   reverse order exchanging the fully reduced blocks in place in dst. */
+enum {
+    PHASE_INIT,
+    PHASE_EXTRA, /* recv from extra rank */
+    PHASE_RS,    /* reduce-scatter loop */
+    PHASE_AG,    /* allgather loop */
+    PHASE_PROXY, /* send from proxy to extra rank */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_EXTRA);                                          \
+            CHECK_PHASE(PHASE_PROXY);                                          \
+            CHECK_PHASE(PHASE_RS);                                             \
+            CHECK_PHASE(PHASE_AG);                                             \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define RESTORE_STATE()                                                        \
+    do {                                                                       \
+        iteration = task->allreduce_kn.iteration;                              \
+        radix_pow = task->allreduce_kn.radix_mask_pow;                         \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->allreduce_kn.phase          = _phase;                            \
+        task->allreduce_kn.iteration      = iteration;                         \
+        task->allreduce_kn.radix_mask_pow = radix_pow;                         \
+    } while (0)
+
+/* Number of ranks in the group of the step defined by radix_pow and the
+   index of myrank in that group. Groups of the last step may be
+   incomplete when the number of full subtrees is less than radix. */
+static inline void sra_kn_step_group(int myrank, int radix, int radix_pow,
+                                     int full_size, int *n_blocks,
+                                     int *my_block)
+{
+    int step_size = radix_pow * radix;
+    int first     = myrank - myrank % step_size + myrank % radix_pow;
+
+    *n_blocks = ucc_min(radix, (full_size - first + radix_pow - 1) / radix_pow);
+    *my_block = (myrank % step_size) / radix_pow;
+}
+
+/* Segment (in elements) of the vector processed by myrank on the step
+   "iteration": it is obtained by applying the block split of all the
+   previous steps */
+static inline void sra_kn_step_segment(int myrank, int radix, int full_size,
+                                       size_t count, int iteration,
+                                       size_t *offset, size_t *len)
+{
+    int radix_pow = 1;
+    int i, n_blocks, my_block;
+
+    *offset = 0;
+    *len    = count;
+    for (i = 0; i < iteration; i++) {
+        sra_kn_step_group(myrank, radix, radix_pow, full_size, &n_blocks,
+                          &my_block);
+        *offset += ucc_buffer_block_offset(*len, n_blocks, my_block);
+        *len     = ucc_buffer_block_count(*len, n_blocks, my_block);
+        radix_pow *= radix;
+    }
+}
+
+/* Max number of elements myrank receives into scratch during the algorithm */
+static size_t sra_kn_scratch_size(int myrank, int radix, int size,
+                                  size_t count)
+{
+    int    radix_pow = 1;
+    size_t max_recv  = 0;
+    int full_tree_size, pow_k_sup, n_full_subtrees, full_size, node_type;
+    int iteration, n_blocks, my_block;
+    size_t seg_offset, seg_len;
+
+    KN_RECURSIVE_SETUP(radix, myrank, size, pow_k_sup, full_tree_size,
+                       n_full_subtrees, full_size, node_type);
+    if (KN_NODE_EXTRA == node_type) {
+        return 0;
+    }
+    if (KN_NODE_PROXY == node_type) {
+        max_recv = count;
+    }
+    for (iteration = 0; iteration < pow_k_sup; iteration++) {
+        sra_kn_step_segment(myrank, radix, full_size, count, iteration,
+                            &seg_offset, &seg_len);
+        sra_kn_step_group(myrank, radix, radix_pow, full_size, &n_blocks,
+                          &my_block);
+        max_recv = ucc_max(max_recv, (n_blocks - 1) *
+                           ucc_buffer_block_count(seg_len, n_blocks, my_block));
+        radix_pow *= radix;
+    }
+    return max_recv;
+}
+
+ucc_status_t
+ucc_tl_ucp_allreduce_sra_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                myrank     = team->rank;
+    int                group_size = team->size;
+    int                radix      = task->allreduce_kn.radix;
+    size_t             count      = task->allreduce_kn.count;
+    ucc_memory_type_t  mem_type   = task->allreduce_kn.mem_type;
+    ucc_datatype_t     dt         = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op         = task->args.reduce.predefined_op;
+    size_t             dt_size    = ucc_dt_size(dt);
+    size_t             data_size  = count * dt_size;
+    void              *scratch    = task->allreduce_kn.scratch;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    void              *sbuf       =
+        UCC_IS_INPLACE(task->args) ? rbuf : task->args.buffer_info.src_buffer;
+    int full_tree_size, pow_k_sup, n_full_subtrees, full_size, node_type;
+    int iteration, radix_pow, k, peer, n_blocks, my_block, blk;
+    size_t       seg_offset, seg_len, blk_offset, blk_count, recv_offset;
+    ucc_status_t status;
+    void        *src;
+
+    KN_RECURSIVE_SETUP(radix, myrank, group_size, pow_k_sup, full_tree_size,
+                       n_full_subtrees, full_size, node_type);
+    RESTORE_STATE();
+    GOTO_PHASE(task->allreduce_kn.phase);
+
+    if (KN_NODE_EXTRA == node_type) {
+        peer = KN_RECURSIVE_GET_PROXY(myrank, full_size);
+        ucc_tl_ucp_send_nb(sbuf, data_size, mem_type, peer, team, task);
+        ucc_tl_ucp_recv_nb(rbuf, data_size, mem_type, peer, team, task);
+    }
+
+    if (KN_NODE_PROXY == node_type) {
+        peer = KN_RECURSIVE_GET_EXTRA(myrank, full_size);
+        ucc_tl_ucp_recv_nb(scratch, data_size, mem_type, peer, team, task);
+    }
+PHASE_EXTRA:
+    if (KN_NODE_PROXY == node_type || KN_NODE_EXTRA == node_type) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_EXTRA);
+            return UCC_INPROGRESS;
+        }
+        if (KN_NODE_EXTRA == node_type) {
+            goto completion;
+        }
+        status = ucc_mc_reduce(sbuf, scratch, rbuf, count, dt, mem_type, op);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce extra data");
+            task->super.super.status = status;
+            return status;
+        }
+    }
+
+    for (; iteration < pow_k_sup; iteration++) {
+        /* On the very first step BASE rank takes its original data,
+           afterwards only its own part of rbuf is being reduced */
+        src = (0 == iteration && KN_NODE_BASE == node_type) ? sbuf : rbuf;
+        sra_kn_step_segment(myrank, radix, full_size, count, iteration,
+                            &seg_offset, &seg_len);
+        sra_kn_step_group(myrank, radix, radix_pow, full_size, &n_blocks,
+                          &my_block);
+        for (k = 1; k < radix; k++) {
+            blk = (my_block + k) % radix;
+            if (blk >= n_blocks)
+                continue;
+            peer       = KN_RECURSIVE_GET_PEER(myrank, k, radix, radix_pow);
+            blk_offset =
+                seg_offset + ucc_buffer_block_offset(seg_len, n_blocks, blk);
+            blk_count = ucc_buffer_block_count(seg_len, n_blocks, blk);
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)src + blk_offset * dt_size),
+                               blk_count * dt_size, mem_type, peer, team, task);
+        }
+
+        blk_count   = ucc_buffer_block_count(seg_len, n_blocks, my_block);
+        recv_offset = 0;
+        for (k = 1; k < radix; k++) {
+            blk = (my_block + k) % radix;
+            if (blk >= n_blocks)
+                continue;
+            peer = KN_RECURSIVE_GET_PEER(myrank, k, radix, radix_pow);
+            ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)scratch + recv_offset),
+                               blk_count * dt_size, mem_type, peer, team, task);
+            recv_offset += blk_count * dt_size;
+        }
+    PHASE_RS:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RS);
+            return UCC_INPROGRESS;
+        }
+        src = (0 == iteration && KN_NODE_BASE == node_type) ? sbuf : rbuf;
+        sra_kn_step_segment(myrank, radix, full_size, count, iteration,
+                            &seg_offset, &seg_len);
+        sra_kn_step_group(myrank, radix, radix_pow, full_size, &n_blocks,
+                          &my_block);
+        blk_offset = (seg_offset +
+                      ucc_buffer_block_offset(seg_len, n_blocks, my_block)) *
+                     dt_size;
+        blk_count  = ucc_buffer_block_count(seg_len, n_blocks, my_block);
+        for (k = 1; k < n_blocks; k++) {
+            status = ucc_mc_reduce(
+                (void *)((ptrdiff_t)((k == 1) ? src : rbuf) + blk_offset),
+                (void *)((ptrdiff_t)scratch + (k - 1) * blk_count * dt_size),
+                (void *)((ptrdiff_t)rbuf + blk_offset), blk_count, dt,
+                mem_type, op);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce step data");
+                task->super.super.status = status;
+                return status;
+            }
+        }
+        radix_pow *= radix;
+    }
+
+    iteration = pow_k_sup - 1;
+    radix_pow = radix_pow / radix;
+    for (; iteration >= 0; iteration--) {
+        sra_kn_step_segment(myrank, radix, full_size, count, iteration,
+                            &seg_offset, &seg_len);
+        sra_kn_step_group(myrank, radix, radix_pow, full_size, &n_blocks,
+                          &my_block);
+        blk_offset = seg_offset +
+                     ucc_buffer_block_offset(seg_len, n_blocks, my_block);
+        blk_count  = ucc_buffer_block_count(seg_len, n_blocks, my_block);
+        for (k = 1; k < radix; k++) {
+            blk = (my_block + k) % radix;
+            if (blk >= n_blocks)
+                continue;
+            peer = KN_RECURSIVE_GET_PEER(myrank, k, radix, radix_pow);
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)rbuf + blk_offset * dt_size),
+                               blk_count * dt_size, mem_type, peer, team, task);
+        }
+        for (k = 1; k < radix; k++) {
+            blk = (my_block + k) % radix;
+            if (blk >= n_blocks)
+                continue;
+            peer = KN_RECURSIVE_GET_PEER(myrank, k, radix, radix_pow);
+            ucc_tl_ucp_recv_nb(
+                (void *)((ptrdiff_t)rbuf +
+                         (seg_offset +
+                          ucc_buffer_block_offset(seg_len, n_blocks, blk)) *
+                             dt_size),
+                ucc_buffer_block_count(seg_len, n_blocks, blk) * dt_size,
+                mem_type, peer, team, task);
+        }
+    PHASE_AG:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_AG);
+            return UCC_INPROGRESS;
+        }
+        radix_pow /= radix;
+    }
+
+    if (KN_NODE_PROXY == node_type) {
+        peer = KN_RECURSIVE_GET_EXTRA(myrank, full_size);
+        ucc_tl_ucp_send_nb(rbuf, data_size, mem_type, peer, team, task);
+        goto PHASE_PROXY;
+    } else {
+        goto completion;
+    }
+
+PHASE_PROXY:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_PROXY);
+        return UCC_INPROGRESS;
+    }
+
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->allreduce_kn.phase          = PHASE_INIT;
+    task->allreduce_kn.iteration      = 0;
+    task->allreduce_kn.radix_mask_pow = 1;
+    task->super.super.status          = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            data_size = task->allreduce_kn.count *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   data_size, task->allreduce_kn.mem_type,
+                                   task->allreduce_kn.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_allreduce_sra_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->allreduce_kn.count   = UCC_COLL_ARGS_COUNT(task->args);
+    task->allreduce_kn.scratch = NULL;
+    task->allreduce_kn.radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.allreduce_sra_kn_radix,
+                team->size);
+    if (task->allreduce_kn.radix < 2) {
+        task->allreduce_kn.radix = 2;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->allreduce_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* Scratch holds either the data of EXTRA rank or the blocks received
+       on a single reduce-scatter step */
+    data_size = sra_kn_scratch_size(team->rank, task->allreduce_kn.radix,
+                                    team->size, task->allreduce_kn.count) *
+                ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->size > 1 && data_size > 0) {
+        status = ucc_mc_alloc(&task->allreduce_kn.scratch, data_size,
+                              task->allreduce_kn.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for allreduce");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_allreduce_sra_knomial_start;
+    task->super.progress = ucc_tl_ucp_allreduce_sra_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_knomial_finalize;
+    return UCC_OK;
+}
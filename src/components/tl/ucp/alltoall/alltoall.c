@@ -0,0 +1,31 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoall.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_alltoall_init(ucc_tl_ucp_task_t *task)
+{
+    size_t dt_size = ucc_dt_size(task->args.buffer_info.src_datatype);
+
+    if (0 == dt_size) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_IS_INPLACE(task->args)) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "inplace alltoall is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* tiny per peer messages: log(size) latencies instead of size - 1 */
+    if (UCC_COLL_ARGS_COUNT(task->args) * dt_size <
+        UCC_TL_UCP_TEAM_CTX(task->team)->cfg.alltoall_bruck_thresh) {
+        return ucc_tl_ucp_alltoall_bruck_init(task);
+    }
+    return ucc_tl_ucp_alltoall_pairwise_init(task);
+}
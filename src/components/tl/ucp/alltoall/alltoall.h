@@ -0,0 +1,20 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef ALLTOALL_H_
+#define ALLTOALL_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Alltoall: src_counts[0] elements of src_datatype are exchanged with every
+   rank, block r of src_buffer goes to rank r and the block received from
+   rank r is placed at block r of dst_buffer */
+ucc_status_t ucc_tl_ucp_alltoall_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_alltoall_pairwise_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init(ucc_tl_ucp_task_t *task);
+
+#endif
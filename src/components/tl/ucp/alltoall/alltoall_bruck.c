@@ -0,0 +1,219 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoall.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Bruck alltoall, ceil(log2(size)) steps. Scratch holds three areas:
+   "blocks" - size blocks, position i has the block travelling to rank
+   (rank + i) on the way in and the one that came from rank (rank - i) on
+   the way out; "send" and "recv" - packing areas of size / 2 blocks. On the
+   step with distance d all positions having bit d set are packed and sent
+   to rank + d, the same positions are received from rank - d. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP, /* bruck steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->alltoall_bruck.phase = _phase;                                   \
+        task->alltoall_bruck.dist  = dist;                                     \
+    } while (0)
+
+#define BRUCK_BLOCK(_area, _i)                                                 \
+    ((void *)((ptrdiff_t)(_area) + (_i) * block_size))
+
+/* Packs (or unpacks) the positions with bit "dist" set */
+static inline ucc_status_t bruck_pack(void *blocks, void *packed, int size,
+                                      int dist, size_t block_size,
+                                      ucc_memory_type_t mem_type, int unpack)
+{
+    ucc_status_t status = UCC_OK;
+    int          i, n;
+
+    for (i = dist, n = 0; i < size && UCC_OK == status; i++) {
+        if (!(i & dist)) {
+            continue;
+        }
+        status = unpack ? ucc_mc_memcpy(BRUCK_BLOCK(blocks, i),
+                                        BRUCK_BLOCK(packed, n), block_size,
+                                        mem_type, mem_type)
+                        : ucc_mc_memcpy(BRUCK_BLOCK(packed, n),
+                                        BRUCK_BLOCK(blocks, i), block_size,
+                                        mem_type, mem_type);
+        n++;
+    }
+    return status;
+}
+
+static inline int bruck_n_packed(int size, int dist)
+{
+    int i, n = 0;
+
+    for (i = dist; i < size; i++) {
+        n += !!(i & dist);
+    }
+    return n;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    ucc_memory_type_t  mem_type   = task->alltoall_bruck.mem_type;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    void              *blocks     = task->alltoall_bruck.scratch;
+    void              *send_area  = BRUCK_BLOCK(blocks, size);
+    void              *recv_area  = BRUCK_BLOCK(send_area, size / 2 + 1);
+    int                dist       = task->alltoall_bruck.dist;
+    int                n_packed, i;
+    ucc_status_t       status;
+
+    GOTO_PHASE(task->alltoall_bruck.phase);
+
+    for (; dist < size; dist *= 2) {
+        n_packed = bruck_n_packed(size, dist);
+        status   = bruck_pack(blocks, send_area, size, dist, block_size,
+                              mem_type, 0);
+        if (UCC_OK != status) {
+            task->super.super.status = status;
+            return status;
+        }
+        ucc_tl_ucp_send_nb(send_area, n_packed * block_size, mem_type,
+                           (rank + dist) % size, team, task);
+        ucc_tl_ucp_recv_nb(recv_area, n_packed * block_size, mem_type,
+                           (rank - dist + size) % size, team, task);
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+        status = bruck_pack(blocks, recv_area, size, dist, block_size,
+                            mem_type, 1);
+        if (UCC_OK != status) {
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    /* position i holds the block from rank - i */
+    for (i = 0; i < size; i++) {
+        status = ucc_mc_memcpy(BRUCK_BLOCK(rbuf, (rank - i + size) % size),
+                               BRUCK_BLOCK(blocks, i), block_size,
+                               task->alltoall_bruck.dst_mem_type, mem_type);
+        if (UCC_OK != status) {
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    int                rank = team->rank;
+    int                size = team->size;
+    void              *sbuf = task->args.buffer_info.src_buffer;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->alltoall_bruck.phase = PHASE_INIT;
+    task->alltoall_bruck.dist  = 1;
+    task->super.super.status   = UCC_INPROGRESS;
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    /* rotate src so that position i holds the block for rank + i */
+    status = ucc_mc_memcpy(task->alltoall_bruck.scratch,
+                           BRUCK_BLOCK(sbuf, rank), (size - rank) * block_size,
+                           task->alltoall_bruck.mem_type,
+                           task->alltoall_bruck.src_mem_type);
+    if (UCC_OK == status && rank > 0) {
+        status = ucc_mc_memcpy(
+            BRUCK_BLOCK(task->alltoall_bruck.scratch, size - rank), sbuf,
+            rank * block_size, task->alltoall_bruck.mem_type,
+            task->alltoall_bruck.src_mem_type);
+    }
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_alltoall_bruck_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_mc_free(task->alltoall_bruck.scratch, task->alltoall_bruck.mem_type);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team       = task->team;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    ucc_status_t       status;
+
+    status = ucc_mc_type(task->args.buffer_info.src_buffer,
+                         &task->alltoall_bruck.src_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->alltoall_bruck.dst_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* scratch lives where dst is */
+    task->alltoall_bruck.mem_type = task->alltoall_bruck.dst_mem_type;
+    status = ucc_mc_alloc(&task->alltoall_bruck.scratch,
+                          ucc_max((team->size + 2 * (team->size / 2 + 1)) *
+                                      block_size, 1),
+                          task->alltoall_bruck.mem_type);
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "failed to allocate scratch for alltoall");
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_alltoall_bruck_start;
+    task->super.progress = ucc_tl_ucp_alltoall_bruck_progress;
+    task->super.finalize = ucc_tl_ucp_alltoall_bruck_finalize;
+    return UCC_OK;
+}
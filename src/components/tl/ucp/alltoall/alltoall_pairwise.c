@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoall.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Pairwise exchange alltoall: on step i rank sends to rank + i and receives
+   from rank - i. Steps are posted in order as long as there are less than
+   n_posts outstanding sends and receives, so a rank is never flooded with
+   unexpected messages from the whole team. */
+
+ucc_status_t ucc_tl_ucp_alltoall_pairwise_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    uint32_t           n_steps    = size - 1;
+    uint32_t           n_posts    = task->alltoall_pairwise.n_posts;
+    void              *sbuf       = task->args.buffer_info.src_buffer;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    uint32_t           polls      = 0;
+    int                step, peer;
+
+    /* posted counters are the state: step i is posted as send i - 1 */
+    while (task->send_posted < n_steps) {
+        while (task->send_posted < n_steps &&
+               task->send_posted - task->send_completed < n_posts &&
+               task->recv_posted - task->recv_completed < n_posts) {
+            step = task->send_posted + 1;
+            peer = (rank + step) % size;
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)sbuf + peer * block_size),
+                               block_size, task->alltoall_pairwise.src_mem_type,
+                               peer, team, task);
+            peer = (rank - step + size) % size;
+            ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)rbuf + peer * block_size),
+                               block_size, task->alltoall_pairwise.dst_mem_type,
+                               peer, team, task);
+        }
+        if (task->send_posted == n_steps) {
+            break;
+        }
+        if (polls++ >= task->n_polls) {
+            return UCC_INPROGRESS;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_pairwise_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    /* progress keeps the step in the posted counters, rewind them for
+       the repost of a persistent request */
+    task->send_posted        = 0;
+    task->send_completed     = 0;
+    task->recv_posted        = 0;
+    task->recv_completed     = 0;
+    task->super.super.status = UCC_INPROGRESS;
+    /* own block doesn't go through the network */
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    status = ucc_mc_memcpy(
+        (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                 team->rank * block_size),
+        (void *)((ptrdiff_t)task->args.buffer_info.src_buffer +
+                 team->rank * block_size),
+        block_size, task->alltoall_pairwise.dst_mem_type,
+        task->alltoall_pairwise.src_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_alltoall_pairwise_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_pairwise_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->alltoall_pairwise.n_posts =
+        ucc_max(UCC_TL_UCP_TEAM_CTX(team)->cfg.alltoall_pairwise_num_posts, 1);
+    status = ucc_mc_type(task->args.buffer_info.src_buffer,
+                         &task->alltoall_pairwise.src_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->alltoall_pairwise.dst_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_alltoall_pairwise_start;
+    task->super.progress = ucc_tl_ucp_alltoall_pairwise_progress;
+    return UCC_OK;
+}
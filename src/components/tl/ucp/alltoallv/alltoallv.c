@@ -0,0 +1,25 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoallv.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_alltoallv_init(ucc_tl_ucp_task_t *task)
+{
+    if ((0 == ucc_dt_size(task->args.buffer_info.src_datatype)) ||
+        (0 == ucc_dt_size(task->args.buffer_info.dst_datatype))) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_IS_INPLACE(task->args)) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "inplace alltoallv is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    return ucc_tl_ucp_alltoallv_pairwise_init(task);
+}
@@ -0,0 +1,18 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef ALLTOALLV_H_
+#define ALLTOALLV_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Alltoallv: src_counts[r] elements of src_datatype at src_displacements[r]
+   go to rank r, dst_counts[r] elements of dst_datatype are received from
+   rank r at dst_displacements[r]. Displacements are in elements. */
+ucc_status_t ucc_tl_ucp_alltoallv_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoallv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Pairwise exchange alltoallv: on step i rank sends to rank + i and receives
+   from rank - i, zero sized transfers are not posted at all. Like the
+   alltoall, steps are posted only while there are less than n_posts
+   outstanding sends and receives. */
+
+ucc_status_t ucc_tl_ucp_alltoallv_pairwise_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t      *team     = task->team;
+    ucc_coll_buffer_info_t *info     = &task->args.buffer_info;
+    int                     rank     = team->rank;
+    int                     size     = team->size;
+    uint32_t                n_posts  = task->alltoallv_pairwise.n_posts;
+    size_t                  sdt_size = ucc_dt_size(info->src_datatype);
+    size_t                  rdt_size = ucc_dt_size(info->dst_datatype);
+    int                     polls    = 0;
+    int                     peer;
+    size_t                  count, displ;
+
+    while (task->alltoallv_pairwise.step < size) {
+        while (task->alltoallv_pairwise.step < size &&
+               task->send_posted - task->send_completed < n_posts &&
+               task->recv_posted - task->recv_completed < n_posts) {
+            peer  = (rank + task->alltoallv_pairwise.step) % size;
+            count = ucc_coll_args_get_count(&task->args, info->src_counts,
+                                            peer);
+            if (count > 0) {
+                displ = ucc_coll_args_get_displacement(
+                    &task->args, info->src_displacements, peer);
+                ucc_tl_ucp_send_nb(
+                    (void *)((ptrdiff_t)info->src_buffer + displ * sdt_size),
+                    count * sdt_size, task->alltoallv_pairwise.src_mem_type,
+                    peer, team, task);
+            }
+            peer  = (rank - task->alltoallv_pairwise.step + size) % size;
+            count = ucc_coll_args_get_count(&task->args, info->dst_counts,
+                                            peer);
+            if (count > 0) {
+                displ = ucc_coll_args_get_displacement(
+                    &task->args, info->dst_displacements, peer);
+                ucc_tl_ucp_recv_nb(
+                    (void *)((ptrdiff_t)info->dst_buffer + displ * rdt_size),
+                    count * rdt_size, task->alltoallv_pairwise.dst_mem_type,
+                    peer, team, task);
+            }
+            task->alltoallv_pairwise.step++;
+        }
+        if (task->alltoallv_pairwise.step == size) {
+            break;
+        }
+        if (polls++ >= task->n_polls) {
+            return UCC_INPROGRESS;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_pairwise_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t      *team = task->team;
+    ucc_coll_buffer_info_t *info = &task->args.buffer_info;
+    int                     rank = team->rank;
+    size_t                  count, sdispl, rdispl;
+    ucc_status_t            status;
+
+    task->alltoallv_pairwise.step = 1;
+    task->super.super.status      = UCC_INPROGRESS;
+    /* own block doesn't go through the network */
+    count = ucc_coll_args_get_count(&task->args, info->src_counts, rank);
+    if (count > 0) {
+        sdispl = ucc_coll_args_get_displacement(&task->args,
+                                                info->src_displacements, rank);
+        rdispl = ucc_coll_args_get_displacement(&task->args,
+                                                info->dst_displacements, rank);
+        status = ucc_mc_memcpy(
+            (void *)((ptrdiff_t)info->dst_buffer +
+                     rdispl * ucc_dt_size(info->dst_datatype)),
+            (void *)((ptrdiff_t)info->src_buffer +
+                     sdispl * ucc_dt_size(info->src_datatype)),
+            count * ucc_dt_size(info->src_datatype),
+            task->alltoallv_pairwise.dst_mem_type,
+            task->alltoallv_pairwise.src_mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_alltoallv_pairwise_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->alltoallv_pairwise.n_posts =
+        ucc_max(UCC_TL_UCP_TEAM_CTX(team)->cfg.alltoall_pairwise_num_posts, 1);
+    status = ucc_mc_type(task->args.buffer_info.src_buffer,
+                         &task->alltoallv_pairwise.src_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->alltoallv_pairwise.dst_mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_alltoallv_pairwise_start;
+    task->super.progress = ucc_tl_ucp_alltoallv_pairwise_progress;
+    return UCC_OK;
+}
@@ -6,12 +6,35 @@
 #include "config.h"
 #include "tl_ucp.h"
 #include "barrier.h"
+#include "utils/ucc_math.h"
 
 ucc_status_t ucc_tl_ucp_barrier_knomial_start(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_barrier_knomial_progress(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_barrier_dissemination_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_barrier_dissemination_progress(ucc_coll_task_t *task);
 
 ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task)
 {
+    ucc_tl_ucp_team_t *team      = task->team;
+    int                full_size = 1;
+    int                radix;
+
+    radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.kn_barrier_radix, team->size);
+    if (radix < 2) {
+        radix = 2;
+    }
+    while (full_size < team->size) {
+        full_size *= radix;
+    }
+    /* Both take log_radix(size) rounds when the team is a full knomial
+       tree; otherwise recursive knomial pays two extra hops for the
+       proxy/extra exchange, dissemination does not. */
+    if (full_size != team->size) {
+        task->super.post     = ucc_tl_ucp_barrier_dissemination_start;
+        task->super.progress = ucc_tl_ucp_barrier_dissemination_progress;
+        return UCC_OK;
+    }
     task->super.post     = ucc_tl_ucp_barrier_knomial_start;
     task->super.progress = ucc_tl_ucp_barrier_knomial_progress;
     return UCC_OK;
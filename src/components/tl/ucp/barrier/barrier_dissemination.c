@@ -0,0 +1,98 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "barrier.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Dissemination barrier: on the round with distance d = radix**i every rank
+   notifies ranks + j * d and waits for ranks - j * d, 0 < j < radix,
+   j * d < size. ceil(log_radix(size)) rounds, no proxy/extra ranks. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP,
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->barrier.phase          = _phase;                                 \
+        task->barrier.radix_mask_pow = dist;                                   \
+    } while (0)
+
+ucc_status_t
+ucc_tl_ucp_barrier_dissemination_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                rank  = team->rank;
+    int                size  = team->size;
+    int                radix = task->barrier.radix;
+    int                dist, k, peer;
+
+    dist = task->barrier.radix_mask_pow;
+    GOTO_PHASE(task->barrier.phase);
+
+    for (; dist < size; dist *= radix) {
+        for (k = 1; k < radix && k * dist < size; k++) {
+            peer = (rank + k * dist) % size;
+            ucc_tl_ucp_send_nb(NULL, 0, UCC_MEMORY_TYPE_UNKNOWN, peer, team,
+                               task);
+        }
+        for (k = 1; k < radix && k * dist < size; k++) {
+            peer = (rank - k * dist % size + size) % size;
+            ucc_tl_ucp_recv_nb(NULL, 0, UCC_MEMORY_TYPE_UNKNOWN, peer, team,
+                               task);
+        }
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_dissemination_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->barrier.phase          = PHASE_INIT;
+    task->barrier.radix_mask_pow = 1;
+    task->barrier.radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.kn_barrier_radix, team->size);
+    if (task->barrier.radix < 2) {
+        task->barrier.radix = 2;
+    }
+    task->super.super.status = UCC_INPROGRESS;
+    status = ucc_tl_ucp_barrier_dissemination_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
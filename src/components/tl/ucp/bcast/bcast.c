@@ -0,0 +1,35 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_bcast_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t           *team    = task->team;
+    ucc_tl_ucp_context_config_t *cfg     = &UCC_TL_UCP_TEAM_CTX(team)->cfg;
+    size_t                       count   = UCC_COLL_ARGS_COUNT(task->args);
+    size_t                       dt_size =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+
+    if (0 == dt_size) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* the whole message crosses the chain in size - 1 + n_frags fragment
+       steps, so it only pays off while the team is small compared to the
+       number of fragments */
+    if (team->size <= cfg->bcast_chain_max_team_size &&
+        count * dt_size >= cfg->bcast_chain_thresh) {
+        return ucc_tl_ucp_bcast_chain_init(task);
+    }
+    if (count >= team->size && count * dt_size >= cfg->bcast_sag_thresh) {
+        return ucc_tl_ucp_bcast_sag_init(task);
+    }
+    return ucc_tl_ucp_bcast_knomial_init(task);
+}
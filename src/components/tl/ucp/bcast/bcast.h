@@ -0,0 +1,22 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef BCAST_H_
+#define BCAST_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Bcast operates on buffer_info.dst_buffer on every rank: root provides
+   the data in it, count and datatype are taken from src_counts[0] and
+   src_datatype */
+ucc_status_t ucc_tl_ucp_bcast_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_bcast_knomial_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_bcast_sag_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_bcast_chain_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Pipelined chain bcast: vrank i receives from vrank i - 1 and forwards to
+   vrank i + 1. The buffer is cut into fragments of frag_count elements, a
+   fragment is forwarded as soon as it arrives, so the whole message crosses
+   the chain in (size - 1 + n_frags) fragment steps. Up to max_inflight
+   fragments are being received and sent at a time. */
+enum {
+    PHASE_INIT,
+    PHASE_CHAIN, /* pipelined receive and forward */
+    PHASE_FLUSH, /* wait for the last sends */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_CHAIN);                                          \
+            CHECK_PHASE(PHASE_FLUSH);                                          \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->bcast_chain.phase = _phase;                                      \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_bcast_chain_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team         = task->team;
+    int                size         = team->size;
+    int                root         = (int)task->args.root;
+    int                vrank        = KN_TREE_VRANK(team->rank, root, size);
+    ucc_memory_type_t  mem_type     = task->bcast_chain.mem_type;
+    void              *buf          = task->args.buffer_info.dst_buffer;
+    size_t             count        = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             frag_count   = task->bcast_chain.frag_count;
+    int                n_frags      = task->bcast_chain.n_frags;
+    int                max_inflight = task->bcast_chain.max_inflight;
+    size_t             dt_size      =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int    sendto   = (vrank < size - 1) ? KN_TREE_RANK(vrank + 1, root, size)
+                                         : -1;
+    int    recvfrom = KN_TREE_RANK(vrank - 1 + size, root, size);
+    int    polls    = 0;
+    int    frag;
+    size_t offset, len;
+    ucc_tl_ucp_frag_slot_t *slot;
+    ucc_status_t            status;
+
+    GOTO_PHASE(task->bcast_chain.phase);
+
+PHASE_CHAIN:
+    while (task->bcast_chain.processed < n_frags) {
+        /* root has the data, others keep the receive window full */
+        while (vrank != 0 && task->bcast_chain.recvs_posted < n_frags &&
+               task->bcast_chain.recvs_posted <
+                   task->bcast_chain.processed + max_inflight) {
+            frag   = task->bcast_chain.recvs_posted;
+            slot   = &task->bcast_chain.frags[frag % max_inflight];
+            offset = frag * frag_count;
+            len    = ucc_min(frag_count, count - offset);
+            slot->completed = 0;
+            status = ucc_tl_ucp_recv_frag_nb(
+                (void *)((ptrdiff_t)buf + offset * dt_size), len * dt_size,
+                mem_type, recvfrom, team, task, slot);
+            if (UCC_OK != status) {
+                task->super.super.status = status;
+                return status;
+            }
+            task->bcast_chain.recvs_posted++;
+        }
+
+        /* forward fragments in order, as they arrive */
+        frag = task->bcast_chain.processed;
+        if ((vrank == 0 ||
+             task->bcast_chain.frags[frag % max_inflight].completed) &&
+            (sendto < 0 ||
+             task->send_posted - task->send_completed < max_inflight)) {
+            if (sendto >= 0) {
+                offset = frag * frag_count;
+                len    = ucc_min(frag_count, count - offset);
+                ucc_tl_ucp_send_nb((void *)((ptrdiff_t)buf + offset * dt_size),
+                                   len * dt_size, mem_type, sendto, team, task);
+            }
+            task->bcast_chain.processed++;
+            continue;
+        }
+        if (polls++ >= task->n_polls) {
+            SAVE_STATE(PHASE_CHAIN);
+            return UCC_INPROGRESS;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+    }
+
+PHASE_FLUSH:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_FLUSH);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_chain_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->bcast_chain.phase        = PHASE_INIT;
+    task->bcast_chain.recvs_posted = 0;
+    task->bcast_chain.processed    = 0;
+    task->super.super.status       = UCC_INPROGRESS;
+    if (1 == team->size) {
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_bcast_chain_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_chain_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_free(task->bcast_chain.frags);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_bcast_chain_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t    *team  = task->team;
+    ucc_tl_ucp_context_t *ctx   = UCC_TL_UCP_TEAM_CTX(team);
+    size_t                count = UCC_COLL_ARGS_COUNT(task->args);
+    size_t                dt_size =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+    ucc_status_t status;
+    int          i;
+
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->bcast_chain.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->bcast_chain.frag_count =
+        ucc_max(ctx->cfg.bcast_chain_frag_size / dt_size, 1);
+    task->bcast_chain.n_frags =
+        ucc_max((count + task->bcast_chain.frag_count - 1) /
+                    task->bcast_chain.frag_count, 1);
+    task->bcast_chain.max_inflight = ucc_max(ctx->cfg.bcast_chain_n_frags, 1);
+    task->bcast_chain.frags =
+        ucc_malloc(task->bcast_chain.max_inflight *
+                       sizeof(ucc_tl_ucp_frag_slot_t),
+                   "bcast_chain_frags");
+    if (!task->bcast_chain.frags) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "failed to allocate %zd bytes for chain fragments",
+                 task->bcast_chain.max_inflight *
+                     sizeof(ucc_tl_ucp_frag_slot_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < task->bcast_chain.max_inflight; i++) {
+        task->bcast_chain.frags[i].task      = task;
+        task->bcast_chain.frags[i].completed = 0;
+    }
+    task->super.post     = ucc_tl_ucp_bcast_chain_start;
+    task->super.progress = ucc_tl_ucp_bcast_chain_progress;
+    task->super.finalize = ucc_tl_ucp_bcast_chain_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Scatter-allgather (van de Geijn) bcast. The buffer is split into "size"
+   blocks, block i belongs to virtual rank i (vrank 0 is the root). The
+   blocks are scattered over the knomial tree: every rank receives the
+   contiguous range of blocks of its subtree right into the user buffer.
+   Then ring allgather over vranks completes the buffer on every rank. */
+enum {
+    PHASE_INIT,
+    PHASE_SCATTER, /* knomial scatter from the root */
+    PHASE_RING,    /* ring allgather */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_SCATTER);                                        \
+            CHECK_PHASE(PHASE_RING);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->bcast_sag.phase = _phase;                                        \
+        task->bcast_sag.step  = step;                                          \
+    } while (0)
+
+/* Byte range of the blocks [first, last) */
+static inline void sag_blocks_range(size_t count, int size, size_t dt_size,
+                                    int first, int last, size_t *offset,
+                                    size_t *len)
+{
+    size_t end = (last < size) ? ucc_buffer_block_offset(count, size, last)
+                               : count;
+
+    *offset = ucc_buffer_block_offset(count, size, first);
+    *len    = (end - *offset) * dt_size;
+    *offset = *offset * dt_size;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_sag_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team     = task->team;
+    int                size     = team->size;
+    int                root     = (int)task->args.root;
+    int                radix    = task->bcast_sag.radix;
+    int                vrank    = KN_TREE_VRANK(team->rank, root, size);
+    ucc_memory_type_t  mem_type = task->bcast_sag.mem_type;
+    void              *buf      = task->args.buffer_info.dst_buffer;
+    size_t             count    = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             dt_size  =
+        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int    sendto   = KN_TREE_RANK((vrank + 1) % size, root, size);
+    int    recvfrom = KN_TREE_RANK((vrank - 1 + size) % size, root, size);
+    int    level, radix_pow, k, peer, step;
+    size_t offset, len;
+
+    step  = task->bcast_sag.step;
+    level = ucc_kn_tree_level(vrank, radix, size);
+    GOTO_PHASE(task->bcast_sag.phase);
+
+    if (vrank != 0) {
+        sag_blocks_range(count, size, dt_size, vrank, vrank + level, &offset,
+                         &len);
+        peer = KN_TREE_RANK(KN_TREE_PARENT(vrank, radix, level), root, size);
+        ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)buf + offset), len, mem_type,
+                           peer, team, task);
+    }
+PHASE_SCATTER:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_SCATTER);
+        return UCC_INPROGRESS;
+    }
+    for (radix_pow = level / radix; radix_pow > 0; radix_pow /= radix) {
+        for (k = 1; k < radix; k++) {
+            peer = vrank + k * radix_pow;
+            if (peer >= size) {
+                break;
+            }
+            sag_blocks_range(count, size, dt_size, peer, peer + radix_pow,
+                             &offset, &len);
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)buf + offset), len,
+                               mem_type, KN_TREE_RANK(peer, root, size), team,
+                               task);
+        }
+    }
+
+    /* Ring allgather: on step s vrank forwards block vrank - s. Root has
+       the whole buffer, so the ring is open at the root: it only sends. */
+    for (; step < size - 1; step++) {
+        if (vrank != size - 1) {
+            sag_blocks_range(count, size, dt_size,
+                             (vrank - step + size) % size,
+                             (vrank - step + size) % size + 1, &offset, &len);
+            ucc_tl_ucp_send_nb((void *)((ptrdiff_t)buf + offset), len,
+                               mem_type, sendto, team, task);
+        }
+        if (vrank != 0) {
+            sag_blocks_range(count, size, dt_size,
+                             (vrank - step - 1 + size) % size,
+                             (vrank - step - 1 + size) % size + 1, &offset,
+                             &len);
+            ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)buf + offset), len,
+                               mem_type, recvfrom, team, task);
+        }
+    PHASE_RING:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RING);
+            return UCC_INPROGRESS;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_sag_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->bcast_sag.phase    = PHASE_INIT;
+    task->bcast_sag.step     = 0;
+    task->super.super.status = UCC_INPROGRESS;
+    status = ucc_tl_ucp_bcast_sag_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_sag_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->bcast_sag.radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.bcast_kn_radix, team->size);
+    if (task->bcast_sag.radix < 2) {
+        task->bcast_sag.radix = 2;
+    }
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->bcast_sag.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_bcast_sag_start;
+    task->super.progress = ucc_tl_ucp_bcast_sag_progress;
+    return UCC_OK;
+}
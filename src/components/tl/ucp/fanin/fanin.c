@@ -0,0 +1,13 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "fanin.h"
+
+ucc_status_t ucc_tl_ucp_fanin_init(ucc_tl_ucp_task_t *task)
+{
+    return ucc_tl_ucp_fanin_knomial_init(task);
+}
@@ -0,0 +1,15 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef FANIN_H_
+#define FANIN_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+ucc_status_t ucc_tl_ucp_fanin_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "fanin.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+
+/* Knomial fan-in: zero-byte notifications flow up the tree, a rank
+   notifies its parent once all of its children did. Completes on the root
+   when every rank has entered the collective; non-root ranks complete as
+   soon as their notification is delivered. */
+enum {
+    PHASE_INIT,
+    PHASE_RECV, /* recv from the children */
+    PHASE_SEND, /* send to the parent */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RECV);                                           \
+            CHECK_PHASE(PHASE_SEND);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->fanin_kn.phase = _phase;                                         \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                size  = team->size;
+    int                root  = (int)task->args.root;
+    int                radix = task->fanin_kn.radix;
+    int                vrank = KN_TREE_VRANK(team->rank, root, size);
+    int                level, radix_pow, k, peer;
+
+    level = ucc_kn_tree_level(vrank, radix, size);
+    GOTO_PHASE(task->fanin_kn.phase);
+
+    for (radix_pow = 1; radix_pow < level; radix_pow *= radix) {
+        for (k = 1; k < radix; k++) {
+            peer = vrank + k * radix_pow;
+            if (peer >= size) {
+                break;
+            }
+            ucc_tl_ucp_recv_nb(NULL, 0, UCC_MEMORY_TYPE_UNKNOWN,
+                               KN_TREE_RANK(peer, root, size), team, task);
+        }
+    }
+PHASE_RECV:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_RECV);
+        return UCC_INPROGRESS;
+    }
+    if (vrank != 0) {
+        peer = KN_TREE_RANK(KN_TREE_PARENT(vrank, radix, level), root, size);
+        ucc_tl_ucp_send_nb(NULL, 0, UCC_MEMORY_TYPE_UNKNOWN, peer, team, task);
+    }
+PHASE_SEND:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_SEND);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->fanin_kn.phase     = PHASE_INIT;
+    task->super.super.status = UCC_INPROGRESS;
+    status = ucc_tl_ucp_fanin_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+
+    task->fanin_kn.radix =
+        ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.fanin_kn_radix, team->size);
+    if (task->fanin_kn.radix < 2) {
+        task->fanin_kn.radix = 2;
+    }
+    task->super.post     = ucc_tl_ucp_fanin_knomial_start;
+    task->super.progress = ucc_tl_ucp_fanin_knomial_progress;
+    return UCC_OK;
+}
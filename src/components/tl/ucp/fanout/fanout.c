@@ -0,0 +1,13 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "fanout.h"
+
+ucc_status_t ucc_tl_ucp_fanout_init(ucc_tl_ucp_task_t *task)
+{
+    return ucc_tl_ucp_fanout_knomial_init(task);
+}
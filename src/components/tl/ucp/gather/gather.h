@@ -0,0 +1,21 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef GATHER_H_
+#define GATHER_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Gather: every rank contributes src_counts[0] elements of src_datatype,
+   contribution of rank r lands at block r of dst_buffer of the root. With
+   UCC_COLL_BUFF_FLAG_IN_PLACE root contribution is already in its block
+   of dst_buffer. dst_buffer of non-root ranks is not accessed. */
+ucc_status_t ucc_tl_ucp_gather_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gather_knomial_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gather_linear_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "gather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial gather. Subtree of vrank v on the level L spans the contiguous
+   range of vranks [v, v + L), so every rank collects the blocks of its
+   subtree in vrank order in one buffer and forwards them to the parent as
+   a single message: root gets (radix - 1) * log_radix(size) messages. Root
+   collects right into dst if it is rank 0, otherwise into scratch which is
+   rotated into dst in the end. */
+enum {
+    PHASE_INIT,
+    PHASE_RECV, /* recv from the children */
+    PHASE_SEND, /* send to the parent */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RECV);                                           \
+            CHECK_PHASE(PHASE_SEND);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->gather_kn.phase = _phase;                                        \
+    } while (0)
+
+/* Buffer the subtree blocks are collected in */
+static inline void *gather_kn_buf(ucc_tl_ucp_task_t *task, int vrank)
+{
+    if (task->gather_kn.scratch) {
+        return task->gather_kn.scratch;
+    }
+    return (0 == vrank) ? task->args.buffer_info.dst_buffer
+                        : task->args.buffer_info.src_buffer;
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                size       = team->size;
+    int                root       = (int)task->args.root;
+    int                radix      = task->gather_kn.radix;
+    int                vrank      = KN_TREE_VRANK(team->rank, root, size);
+    ucc_memory_type_t  mem_type   = task->gather_kn.mem_type;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    void              *buf        = gather_kn_buf(task, vrank);
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    int                level, radix_pow, k, child, n_blocks;
+    ucc_status_t       status;
+
+    level = ucc_kn_tree_level(vrank, radix, size);
+    GOTO_PHASE(task->gather_kn.phase);
+
+    for (radix_pow = 1; radix_pow < level; radix_pow *= radix) {
+        for (k = 1; k < radix; k++) {
+            child = vrank + k * radix_pow;
+            if (child >= size) {
+                break;
+            }
+            n_blocks = ucc_min(radix_pow, size - child);
+            ucc_tl_ucp_recv_nb(
+                (void *)((ptrdiff_t)buf + (child - vrank) * block_size),
+                n_blocks * block_size, mem_type,
+                KN_TREE_RANK(child, root, size), team, task);
+        }
+    }
+PHASE_RECV:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_RECV);
+        return UCC_INPROGRESS;
+    }
+    if (0 != vrank) {
+        ucc_tl_ucp_send_nb(
+            buf, ucc_min(level, size - vrank) * block_size, mem_type,
+            KN_TREE_RANK(KN_TREE_PARENT(vrank, radix, level), root, size),
+            team, task);
+    }
+PHASE_SEND:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_SEND);
+        return UCC_INPROGRESS;
+    }
+    if (0 == vrank && buf != rbuf) {
+        /* vrank j is rank (j + root) % size */
+        status = ucc_mc_memcpy((void *)((ptrdiff_t)rbuf + root * block_size),
+                               buf, (size - root) * block_size, mem_type,
+                               mem_type);
+        if (UCC_OK == status) {
+            status = ucc_mc_memcpy(
+                rbuf, (void *)((ptrdiff_t)buf + (size - root) * block_size),
+                root * block_size, mem_type, mem_type);
+        }
+        if (UCC_OK != status) {
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                root  = (int)task->args.root;
+    int                vrank = KN_TREE_VRANK(team->rank, root, team->size);
+    void              *buf   = gather_kn_buf(task, vrank);
+    size_t             block_size;
+    ucc_status_t       status;
+    void              *own;
+
+    task->gather_kn.phase    = PHASE_INIT;
+    task->super.super.status = UCC_INPROGRESS;
+    /* own block goes first in the subtree buffer */
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    own        = (0 == vrank && UCC_IS_INPLACE(task->args))
+                     ? (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                                root * block_size)
+                     : task->args.buffer_info.src_buffer;
+    if (buf != own) {
+        status = ucc_mc_memcpy(buf, own, block_size, task->gather_kn.mem_type,
+                               task->gather_kn.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_gather_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->gather_kn.scratch) {
+        ucc_mc_free(task->gather_kn.scratch, task->gather_kn.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                size  = team->size;
+    int                root  = (int)task->args.root;
+    int                vrank = KN_TREE_VRANK(team->rank, root, size);
+    size_t block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int          radix, n_blocks;
+    ucc_status_t status;
+
+    radix = ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.gather_kn_radix, size);
+    if (radix < 2) {
+        radix = 2;
+    }
+    task->gather_kn.radix   = radix;
+    task->gather_kn.scratch = NULL;
+    status = ucc_mc_type((0 == vrank) ? task->args.buffer_info.dst_buffer
+                                      : task->args.buffer_info.src_buffer,
+                         &task->gather_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* leaves send their block right from src, root 0 collects in dst */
+    n_blocks = ucc_min(ucc_kn_tree_level(vrank, radix, size), size - vrank);
+    if ((0 == vrank && 0 != root) || (0 != vrank && n_blocks > 1)) {
+        status = ucc_mc_alloc(&task->gather_kn.scratch,
+                              ucc_max(n_blocks * block_size, 1),
+                              task->gather_kn.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for gather");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_gather_knomial_start;
+    task->super.progress = ucc_tl_ucp_gather_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_gather_knomial_finalize;
+    return UCC_OK;
+}
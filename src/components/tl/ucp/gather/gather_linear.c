@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "gather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Linear gather for large blocks: every rank sends its block to the root
+   directly, the root keeps at most n_posts receives outstanding. */
+
+ucc_status_t ucc_tl_ucp_gather_linear_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                size       = team->size;
+    int                root       = (int)task->args.root;
+    void              *rbuf       = task->args.buffer_info.dst_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int                polls      = 0;
+    int                peer;
+
+    if (team->rank == root) {
+        while (task->gather_linear.step < size) {
+            while (task->gather_linear.step < size &&
+                   task->recv_posted - task->recv_completed <
+                       task->gather_linear.n_posts) {
+                peer = (root + task->gather_linear.step) % size;
+                ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)rbuf +
+                                            peer * block_size),
+                                   block_size, task->gather_linear.mem_type,
+                                   peer, team, task);
+                task->gather_linear.step++;
+            }
+            if (task->gather_linear.step == size) {
+                break;
+            }
+            if (polls++ >= task->n_polls) {
+                return UCC_INPROGRESS;
+            }
+            ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+        }
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gather_linear_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    int                root = (int)task->args.root;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->gather_linear.step = 1;
+    task->super.super.status = UCC_INPROGRESS;
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->rank != root) {
+        ucc_tl_ucp_send_nb(task->args.buffer_info.src_buffer, block_size,
+                           task->gather_linear.mem_type, root, team, task);
+    } else if (!UCC_IS_INPLACE(task->args)) {
+        status = ucc_mc_memcpy(
+            (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                     root * block_size),
+            task->args.buffer_info.src_buffer, block_size,
+            task->gather_linear.mem_type, task->gather_linear.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_gather_linear_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gather_linear_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->gather_linear.n_posts =
+        ucc_max(UCC_TL_UCP_TEAM_CTX(team)->cfg.gather_linear_num_posts, 1);
+    status = ucc_mc_type((team->rank == task->args.root)
+                             ? task->args.buffer_info.dst_buffer
+                             : task->args.buffer_info.src_buffer,
+                         &task->gather_linear.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_gather_linear_start;
+    task->super.progress = ucc_tl_ucp_gather_linear_progress;
+    return UCC_OK;
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "gatherv.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_gatherv_init(ucc_tl_ucp_task_t *task)
+{
+    if (0 == ucc_dt_size(task->args.buffer_info.src_datatype) ||
+        0 == ucc_dt_size(task->args.buffer_info.dst_datatype)) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* counts are known at the root only, so intermediate ranks of a tree
+       could not size their subtree buffers: blocks go to the root
+       directly */
+    return ucc_tl_ucp_gatherv_linear_init(task);
+}
@@ -0,0 +1,19 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef GATHERV_H_
+#define GATHERV_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Gatherv: src_counts[0] elements of src_datatype from src_buffer of rank r
+   land at dst_displacements[r] in dst_buffer of the root. dst_buffer,
+   dst_counts and dst_displacements are significant at the root only.
+   With UCC_COLL_BUFF_FLAG_IN_PLACE root block is already at its place. */
+ucc_status_t ucc_tl_ucp_gatherv_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_init(ucc_tl_ucp_task_t *task);
+
+#endif
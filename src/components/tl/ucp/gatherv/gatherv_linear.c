@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "gatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Linear gatherv: every rank sends its block to the root, the root
+   receives each one right at its displacement keeping at most n_posts
+   receives outstanding. Empty blocks are not transferred. */
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t      *team    = task->team;
+    ucc_coll_buffer_info_t *info    = &task->args.buffer_info;
+    int                     size    = team->size;
+    int                     root    = (int)task->args.root;
+    size_t                  dt_size = ucc_dt_size(info->dst_datatype);
+    int                     polls   = 0;
+    int                     peer;
+    size_t                  count, displ;
+
+    if (team->rank == root) {
+        while (task->gatherv_linear.step < size) {
+            while (task->gatherv_linear.step < size &&
+                   task->recv_posted - task->recv_completed <
+                       task->gatherv_linear.n_posts) {
+                peer  = (root + task->gatherv_linear.step) % size;
+                count = ucc_coll_args_get_count(&task->args, info->dst_counts,
+                                                peer);
+                if (count > 0) {
+                    displ = ucc_coll_args_get_displacement(
+                        &task->args, info->dst_displacements, peer);
+                    ucc_tl_ucp_recv_nb(
+                        (void *)((ptrdiff_t)info->dst_buffer + displ * dt_size),
+                        count * dt_size, task->gatherv_linear.mem_type, peer,
+                        team, task);
+                }
+                task->gatherv_linear.step++;
+            }
+            if (task->gatherv_linear.step == size) {
+                break;
+            }
+            if (polls++ >= task->n_polls) {
+                return UCC_INPROGRESS;
+            }
+            ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+        }
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t      *team = task->team;
+    ucc_coll_buffer_info_t *info = &task->args.buffer_info;
+    int                     root = (int)task->args.root;
+    size_t                  count, displ;
+    ucc_status_t            status;
+
+    task->gatherv_linear.step = 1;
+    task->super.super.status  = UCC_INPROGRESS;
+    count = ucc_coll_args_get_count(&task->args, info->src_counts, 0);
+    if (team->rank != root) {
+        if (count > 0) {
+            ucc_tl_ucp_send_nb(info->src_buffer,
+                               count * ucc_dt_size(info->src_datatype),
+                               task->gatherv_linear.mem_type, root, team,
+                               task);
+        }
+    } else if (!UCC_IS_INPLACE(task->args) && count > 0) {
+        displ  = ucc_coll_args_get_displacement(&task->args,
+                                                info->dst_displacements, root);
+        status = ucc_mc_memcpy(
+            (void *)((ptrdiff_t)info->dst_buffer +
+                     displ * ucc_dt_size(info->dst_datatype)),
+            info->src_buffer, count * ucc_dt_size(info->src_datatype),
+            task->gatherv_linear.mem_type, task->gatherv_linear.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_gatherv_linear_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->gatherv_linear.n_posts =
+        ucc_max(UCC_TL_UCP_TEAM_CTX(team)->cfg.gather_linear_num_posts, 1);
+    status = ucc_mc_type((team->rank == task->args.root)
+                             ? task->args.buffer_info.dst_buffer
+                             : task->args.buffer_info.src_buffer,
+                         &task->gatherv_linear.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_gatherv_linear_start;
+    task->super.progress = ucc_tl_ucp_gatherv_linear_progress;
+    return UCC_OK;
+}
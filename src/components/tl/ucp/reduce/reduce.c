@@ -0,0 +1,20 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
+{
+    if ((task->args.mask & UCC_COLL_ARG_FIELD_USERDEFINED_REDUCTIONS) ||
+        (0 == ucc_dt_size(task->args.buffer_info.src_datatype))) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined reductions/datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    return ucc_tl_ucp_reduce_knomial_init(task);
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef REDUCE_H_
+#define REDUCE_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Rooted reduce: the result is delivered to buffer_info.dst_buffer of the
+   root only, dst_buffer of the other ranks is not accessed */
+ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_init(ucc_tl_ucp_task_t *task);
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial tree reduce, the mirror of the knomial bcast: starting from the
+   lowest level, a rank receives the partial results of all its children of
+   the level at once and reduces them into the accumulator in a single
+   pass, then sends the accumulator to its parent. The receive slots of the
+   scratch are reused on every level. Root accumulates right into dst. */
+enum {
+    PHASE_INIT,
+    PHASE_RECV, /* recv from the children of the level */
+    PHASE_SEND, /* send to the parent */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RECV);                                           \
+            CHECK_PHASE(PHASE_SEND);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->reduce_kn.phase     = _phase;                                    \
+        task->reduce_kn.radix_pow = radix_pow;                                 \
+    } while (0)
+
+/* Number of children of vrank on the tree level radix_pow */
+static inline int reduce_kn_n_children(int vrank, int radix, int size,
+                                       int radix_pow)
+{
+    return ucc_min(radix - 1, (size - 1 - vrank) / radix_pow);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team      = task->team;
+    int                size      = team->size;
+    int                root      = (int)task->args.root;
+    int                radix     = task->reduce_kn.radix;
+    int                vrank     = KN_TREE_VRANK(team->rank, root, size);
+    ucc_memory_type_t  mem_type  = task->reduce_kn.mem_type;
+    ucc_datatype_t     dt        = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op        = task->args.reduce.predefined_op;
+    size_t             count     = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             data_size = count * ucc_dt_size(dt);
+    void              *scratch   = task->reduce_kn.scratch;
+    void              *sbuf      = (0 == vrank && UCC_IS_INPLACE(task->args))
+                                       ? task->args.buffer_info.dst_buffer
+                                       : task->args.buffer_info.src_buffer;
+    int                radix_pow = task->reduce_kn.radix_pow;
+    int                level, k, n_children, peer;
+    ucc_status_t       status;
+    void              *acc;
+
+    /* root reduces right into the user buffer, others into the scratch
+       slot following the receive slots */
+    acc   = (0 == vrank) ? task->args.buffer_info.dst_buffer
+                         : (void *)((ptrdiff_t)scratch +
+                                    (radix - 1) * data_size);
+    level = ucc_kn_tree_level(vrank, radix, size);
+    GOTO_PHASE(task->reduce_kn.phase);
+
+    for (; radix_pow < level; radix_pow *= radix) {
+        n_children = reduce_kn_n_children(vrank, radix, size, radix_pow);
+        if (n_children <= 0) {
+            break;
+        }
+        for (k = 0; k < n_children; k++) {
+            peer = KN_TREE_RANK(vrank + (k + 1) * radix_pow, root, size);
+            ucc_tl_ucp_recv_nb((void *)((ptrdiff_t)scratch + k * data_size),
+                               data_size, mem_type, peer, team, task);
+        }
+    PHASE_RECV:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RECV);
+            return UCC_INPROGRESS;
+        }
+        /* lowest level always has children, if there are any */
+        n_children = reduce_kn_n_children(vrank, radix, size, radix_pow);
+        status = ucc_mc_reduce_multi((1 == radix_pow) ? sbuf : acc, scratch,
+                                     acc, n_children, count, data_size, dt,
+                                     mem_type, op);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce children data");
+            task->super.super.status = status;
+            return status;
+        }
+    }
+
+    if (0 != vrank) {
+        peer = KN_TREE_RANK(KN_TREE_PARENT(vrank, radix, level), root, size);
+        /* leaves forward their own data */
+        ucc_tl_ucp_send_nb(scratch ? acc : sbuf, data_size, mem_type, peer,
+                           team, task);
+    }
+PHASE_SEND:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_SEND);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->reduce_kn.phase     = PHASE_INIT;
+    task->reduce_kn.radix_pow = 1;
+    task->super.super.status  = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            data_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   data_size, task->reduce_kn.mem_type,
+                                   task->reduce_kn.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_reduce_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->reduce_kn.scratch) {
+        ucc_mc_free(task->reduce_kn.scratch, task->reduce_kn.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                size  = team->size;
+    int                vrank = KN_TREE_VRANK(team->rank, (int)task->args.root,
+                                             size);
+    size_t data_size = UCC_COLL_ARGS_COUNT(task->args) *
+                       ucc_dt_size(task->args.buffer_info.src_datatype);
+    int          radix, n_slots;
+    ucc_status_t status;
+
+    radix = ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.reduce_kn_radix, size);
+    if (radix < 2) {
+        radix = 2;
+    }
+    task->reduce_kn.radix   = radix;
+    task->reduce_kn.scratch = NULL;
+    /* non-root ranks never touch dst */
+    status = ucc_mc_type((0 == vrank) ? task->args.buffer_info.dst_buffer
+                                      : task->args.buffer_info.src_buffer,
+                         &task->reduce_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    if (reduce_kn_n_children(vrank, radix, size, 1) > 0 &&
+        ucc_kn_tree_level(vrank, radix, size) > 1) {
+        /* receive slots for the children of one level, plus the
+           accumulator on non-root ranks */
+        n_slots = radix - 1 + (0 != vrank);
+        status  = ucc_mc_alloc(&task->reduce_kn.scratch,
+                               ucc_max(n_slots * data_size, 1),
+                               task->reduce_kn.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for reduce");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_reduce_knomial_start;
+    task->super.progress = ucc_tl_ucp_reduce_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_knomial_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+#include "utils/ucc_coll_utils.h"
+#include "utils/ucc_math.h"
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             dt_size;
+
+    dt_size = ucc_dt_size(task->args.buffer_info.src_datatype);
+    if ((task->args.mask & UCC_COLL_ARG_FIELD_USERDEFINED_REDUCTIONS) ||
+        (0 == dt_size)) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined reductions/datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* recursive halving takes log(size) steps instead of size - 1 and
+       moves the same amount of data, but its messages get large at the
+       first steps */
+    if (ucc_is_pow2(team->size) &&
+        UCC_COLL_ARGS_COUNT(task->args) * dt_size <
+            UCC_TL_UCP_TEAM_CTX(team)->cfg.reduce_scatter_ring_thresh) {
+        return ucc_tl_ucp_reduce_scatter_rh_init(task);
+    }
+    return ucc_tl_ucp_reduce_scatter_ring_init(task);
+}
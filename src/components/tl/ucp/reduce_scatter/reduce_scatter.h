@@ -0,0 +1,21 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef REDUCE_SCATTER_H_
+#define REDUCE_SCATTER_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Reduce-scatter: src_buffer holds "size" blocks of src_counts[0] elements,
+   block r of the reduction result lands in dst_buffer of rank r. With
+   UCC_COLL_BUFF_FLAG_IN_PLACE dst_buffer holds all the blocks on input and
+   the result is written to block "rank" of it. */
+ucc_status_t ucc_tl_ucp_reduce_scatter_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_rh_init(ucc_tl_ucp_task_t *task);
+
+#endif
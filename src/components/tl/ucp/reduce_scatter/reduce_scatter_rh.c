@@ -0,0 +1,198 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Recursive halving reduce-scatter for power of two teams. On the step
+   with distance d rank owns the range of 2d blocks that contains its own
+   block, exchanges the half that does not contain it with rank ^ d and
+   reduces the received half into its own one. Partial results live in
+   scratch (dst when in place), indexed from the half kept on the first
+   step. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP, /* halving steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->reduce_scatter_rh.phase = _phase;                                \
+        task->reduce_scatter_rh.dist  = dist;                                  \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_rh_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    ucc_memory_type_t  mem_type   = task->reduce_scatter_rh.mem_type;
+    ucc_datatype_t     dt         = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op         = task->args.reduce.predefined_op;
+    size_t             count      = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             block_size = count * ucc_dt_size(dt);
+    int                inplace    = UCC_IS_INPLACE(task->args);
+    void              *dst        = task->args.buffer_info.dst_buffer;
+    void              *sbuf       = inplace ? dst
+                                            : task->args.buffer_info.src_buffer;
+    int                dist       = task->reduce_scatter_rh.dist;
+    void              *acc, *tmp, *src, *rbuf;
+    int                acc_base, keep, give;
+    ucc_status_t       status;
+
+    if (inplace) {
+        acc      = dst;
+        acc_base = 0;
+        tmp      = task->reduce_scatter_rh.scratch;
+    } else {
+        acc      = task->reduce_scatter_rh.scratch;
+        acc_base = (rank & (size / 2)) ? size / 2 : 0;
+        tmp      = (void *)((ptrdiff_t)acc + size / 2 * block_size);
+    }
+    GOTO_PHASE(task->reduce_scatter_rh.phase);
+
+    for (; dist > 0; dist /= 2) {
+        keep = (rank & ~(2 * dist - 1)) + (rank & dist);
+        give = keep ^ dist;
+        if (dist == size / 2) {
+            src = (void *)((ptrdiff_t)sbuf + give * block_size);
+        } else {
+            src = (void *)((ptrdiff_t)acc + (give - acc_base) * block_size);
+        }
+        ucc_tl_ucp_send_nb(src, dist * block_size, mem_type, rank ^ dist, team,
+                           task);
+        ucc_tl_ucp_recv_nb(tmp, dist * block_size, mem_type, rank ^ dist, team,
+                           task);
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+        keep = (rank & ~(2 * dist - 1)) + (rank & dist);
+        if (dist == size / 2) {
+            src = (void *)((ptrdiff_t)sbuf + keep * block_size);
+        } else {
+            src = (void *)((ptrdiff_t)acc + (keep - acc_base) * block_size);
+        }
+        if (1 == dist) {
+            rbuf = inplace ? (void *)((ptrdiff_t)dst + rank * block_size) : dst;
+        } else {
+            rbuf = (void *)((ptrdiff_t)acc + (keep - acc_base) * block_size);
+        }
+        status = ucc_mc_reduce(src, tmp, rbuf, dist * count, dt, mem_type, op);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce halving step");
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_rh_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->reduce_scatter_rh.phase = PHASE_INIT;
+    task->reduce_scatter_rh.dist  = team->size / 2;
+    task->super.super.status      = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                         ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   block_size,
+                                   task->reduce_scatter_rh.mem_type,
+                                   task->reduce_scatter_rh.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_reduce_scatter_rh_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_rh_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->reduce_scatter_rh.scratch) {
+        ucc_mc_free(task->reduce_scatter_rh.scratch,
+                    task->reduce_scatter_rh.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_rh_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             scratch_size;
+    ucc_status_t       status;
+
+    ucc_assert(ucc_is_pow2(team->size));
+    task->reduce_scatter_rh.scratch = NULL;
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->reduce_scatter_rh.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* receive buffer for half of the blocks, plus the partial results
+       unless they are kept in dst */
+    scratch_size = team->size / 2 * UCC_COLL_ARGS_COUNT(task->args) *
+                   ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (!UCC_IS_INPLACE(task->args)) {
+        scratch_size *= 2;
+    }
+    if (team->size > 1) {
+        status = ucc_mc_alloc(&task->reduce_scatter_rh.scratch,
+                              ucc_max(scratch_size, 1),
+                              task->reduce_scatter_rh.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for reduce_scatter");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_reduce_scatter_rh_start;
+    task->super.progress = ucc_tl_ucp_reduce_scatter_rh_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_scatter_rh_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Ring reduce-scatter: on step s rank sends its partial result of block
+   (rank - s - 1) to the right neighbor, receives the partial result of
+   block (rank - s - 2) from the left one and adds its own contribution.
+   After size - 1 steps the block "rank" is complete. Scratch holds the
+   partial result and the receive buffer. */
+enum {
+    PHASE_INIT,
+    PHASE_RING, /* ring steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RING);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->reduce_scatter_ring.phase = _phase;                              \
+        task->reduce_scatter_ring.step  = step;                                \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                rank       = team->rank;
+    int                size       = team->size;
+    int                sendto     = (rank + 1) % size;
+    int                recvfrom   = (rank - 1 + size) % size;
+    ucc_memory_type_t  mem_type   = task->reduce_scatter_ring.mem_type;
+    ucc_datatype_t     dt         = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op         = task->args.reduce.predefined_op;
+    size_t             count      = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             block_size = count * ucc_dt_size(dt);
+    void              *acc        = task->reduce_scatter_ring.scratch;
+    void              *tmp  = (void *)((ptrdiff_t)acc + block_size);
+    void              *sbuf = UCC_IS_INPLACE(task->args)
+                                  ? task->args.buffer_info.dst_buffer
+                                  : task->args.buffer_info.src_buffer;
+    int                step = task->reduce_scatter_ring.step;
+    void              *rbuf;
+    int                send_block, recv_block;
+    ucc_status_t       status;
+
+    GOTO_PHASE(task->reduce_scatter_ring.phase);
+
+    for (; step < size - 1; step++) {
+        send_block = (rank - step - 1 + size) % size;
+        ucc_tl_ucp_send_nb((0 == step) ? (void *)((ptrdiff_t)sbuf +
+                                                  send_block * block_size)
+                                       : acc,
+                           block_size, mem_type, sendto, team, task);
+        ucc_tl_ucp_recv_nb(tmp, block_size, mem_type, recvfrom, team, task);
+    PHASE_RING:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_RING);
+            return UCC_INPROGRESS;
+        }
+        recv_block = (rank - step - 2 + size) % size;
+        if (step == size - 2) {
+            rbuf = UCC_IS_INPLACE(task->args)
+                       ? (void *)((ptrdiff_t)task->args.buffer_info.dst_buffer +
+                                  rank * block_size)
+                       : task->args.buffer_info.dst_buffer;
+        } else {
+            rbuf = acc;
+        }
+        status = ucc_mc_reduce((void *)((ptrdiff_t)sbuf +
+                                        recv_block * block_size),
+                               tmp, rbuf, count, dt, mem_type, op);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce ring block");
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->reduce_scatter_ring.phase = PHASE_INIT;
+    task->reduce_scatter_ring.step  = 0;
+    task->super.super.status        = UCC_INPROGRESS;
+    if (1 == team->size) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                         ucc_dt_size(task->args.buffer_info.src_datatype);
+            status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer,
+                                   task->args.buffer_info.src_buffer,
+                                   block_size,
+                                   task->reduce_scatter_ring.mem_type,
+                                   task->reduce_scatter_ring.mem_type);
+            if (UCC_OK != status) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_reduce_scatter_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->reduce_scatter_ring.scratch) {
+        ucc_mc_free(task->reduce_scatter_ring.scratch,
+                    task->reduce_scatter_ring.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->reduce_scatter_ring.scratch = NULL;
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->reduce_scatter_ring.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->size > 1) {
+        status = ucc_mc_alloc(&task->reduce_scatter_ring.scratch,
+                              ucc_max(2 * block_size, 1),
+                              task->reduce_scatter_ring.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for reduce_scatter");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_reduce_scatter_ring_start;
+    task->super.progress = ucc_tl_ucp_reduce_scatter_ring_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_scatter_ring_finalize;
+    return UCC_OK;
+}
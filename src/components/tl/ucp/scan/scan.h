@@ -0,0 +1,18 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef SCAN_H_
+#define SCAN_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Scan: dst_buffer of rank r gets src_0 op src_1 op ... op src_r.
+   Exscan: the same without src_r, dst_buffer of rank 0 is not touched.
+   With UCC_COLL_BUFF_FLAG_IN_PLACE the input is taken from dst_buffer. */
+ucc_status_t ucc_tl_ucp_scan_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_scan_rd_init(ucc_tl_ucp_task_t *task);
+
+#endif
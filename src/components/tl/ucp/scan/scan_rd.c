@@ -0,0 +1,194 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scan.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Recursive doubling scan/exscan, any team size. On the step with distance
+   d rank sends its partial reduction of ranks (rank - d, rank] to rank + d
+   and receives the one of (rank - 2d, rank - d] from rank - d, so after the
+   step its partial covers (rank - 2d, rank]. Received data always comes
+   from lower ranks, so it is the left operand of the reduction. For scan
+   partial and result are the same vector kept in dst; exscan keeps partial
+   in scratch and the result, which excludes the own contribution, in dst. */
+enum {
+    PHASE_INIT,
+    PHASE_LOOP, /* doubling steps */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_LOOP);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->scan_rd.phase = _phase;                                          \
+        task->scan_rd.dist  = dist;                                            \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_scan_rd_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team      = task->team;
+    int                rank      = team->rank;
+    int                size      = team->size;
+    ucc_memory_type_t  mem_type  = task->scan_rd.mem_type;
+    ucc_datatype_t     dt        = task->args.buffer_info.src_datatype;
+    ucc_reduction_op_t op        = task->args.reduce.predefined_op;
+    size_t             count     = UCC_COLL_ARGS_COUNT(task->args);
+    size_t             data_size = count * ucc_dt_size(dt);
+    void              *rbuf      = task->args.buffer_info.dst_buffer;
+    void              *tmp       = task->scan_rd.scratch;
+    int                dist      = task->scan_rd.dist;
+    void              *partial;
+    ucc_status_t       status;
+
+    if (UCC_COLL_TYPE_EXSCAN == task->args.coll_type) {
+        partial = (void *)((ptrdiff_t)tmp + data_size);
+    } else {
+        partial = rbuf;
+    }
+    GOTO_PHASE(task->scan_rd.phase);
+
+    for (; dist < size; dist *= 2) {
+        if (rank + dist < size) {
+            ucc_tl_ucp_send_nb(partial, data_size, mem_type, rank + dist,
+                               team, task);
+        }
+        if (rank - dist >= 0) {
+            ucc_tl_ucp_recv_nb(tmp, data_size, mem_type, rank - dist, team,
+                               task);
+        }
+    PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+        if (rank - dist < 0) {
+            continue;
+        }
+        if (partial != rbuf) {
+            /* exscan result: first received vector is the own
+               contribution of rank - 1 */
+            if (1 == dist) {
+                status = ucc_mc_memcpy(rbuf, tmp, data_size, mem_type,
+                                       mem_type);
+            } else {
+                status = ucc_mc_reduce(tmp, rbuf, rbuf, count, dt, mem_type,
+                                       op);
+            }
+            if (UCC_OK != status) {
+                goto err;
+            }
+        }
+        if (dist * 2 < size || partial == rbuf) {
+            status = ucc_mc_reduce(tmp, partial, partial, count, dt, mem_type,
+                                   op);
+            if (UCC_OK != status) {
+                goto err;
+            }
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+err:
+    tl_error(UCC_TL_TEAM_LIB(team), "failed to reduce scan step");
+    task->super.super.status = status;
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_scan_rd_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_memory_type_t  mem_type = task->scan_rd.mem_type;
+    size_t             data_size;
+    void              *sbuf, *partial;
+    ucc_status_t       status = UCC_OK;
+
+    task->scan_rd.phase      = PHASE_INIT;
+    task->scan_rd.dist       = 1;
+    task->super.super.status = UCC_INPROGRESS;
+    data_size = UCC_COLL_ARGS_COUNT(task->args) *
+                ucc_dt_size(task->args.buffer_info.src_datatype);
+    sbuf = UCC_IS_INPLACE(task->args) ? task->args.buffer_info.dst_buffer
+                                      : task->args.buffer_info.src_buffer;
+    if (UCC_COLL_TYPE_EXSCAN == task->args.coll_type) {
+        partial = (void *)((ptrdiff_t)task->scan_rd.scratch + data_size);
+    } else {
+        partial = task->args.buffer_info.dst_buffer;
+    }
+    if (partial != sbuf) {
+        status = ucc_mc_memcpy(partial, sbuf, data_size, mem_type, mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_scan_rd_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scan_rd_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->scan_rd.scratch) {
+        ucc_mc_free(task->scan_rd.scratch, task->scan_rd.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_scan_rd_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    size_t             data_size;
+    ucc_status_t       status;
+
+    task->scan_rd.scratch = NULL;
+    status = ucc_mc_type(task->args.buffer_info.dst_buffer,
+                         &task->scan_rd.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* receive buffer, plus the partial reduction for exscan */
+    data_size = UCC_COLL_ARGS_COUNT(task->args) *
+                ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (UCC_COLL_TYPE_EXSCAN == task->args.coll_type) {
+        data_size *= 2;
+    }
+    status = ucc_mc_alloc(&task->scan_rd.scratch, ucc_max(data_size, 1),
+                          task->scan_rd.mem_type);
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate scratch for scan");
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_scan_rd_start;
+    task->super.progress = ucc_tl_ucp_scan_rd_progress;
+    task->super.finalize = ucc_tl_ucp_scan_rd_finalize;
+    return UCC_OK;
+}
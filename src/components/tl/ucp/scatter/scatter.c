@@ -0,0 +1,27 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatter.h"
+#include "utils/ucc_coll_utils.h"
+
+ucc_status_t ucc_tl_ucp_scatter_init(ucc_tl_ucp_task_t *task)
+{
+    size_t dt_size = ucc_dt_size(task->args.buffer_info.src_datatype);
+
+    if (0 == dt_size) {
+        tl_error(UCC_TL_TEAM_LIB(task->team),
+                 "user defined datatypes are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    /* forwarding along the tree costs extra copies of the data, large
+       blocks go straight from the root */
+    if (UCC_COLL_ARGS_COUNT(task->args) * dt_size >=
+        UCC_TL_UCP_TEAM_CTX(task->team)->cfg.scatter_linear_thresh) {
+        return ucc_tl_ucp_scatter_linear_init(task);
+    }
+    return ucc_tl_ucp_scatter_knomial_init(task);
+}
@@ -0,0 +1,22 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef SCATTER_H_
+#define SCATTER_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+/* Scatter: block r of src_buffer of the root, src_counts[0] elements of
+   src_datatype, lands in dst_buffer of rank r. With
+   UCC_COLL_BUFF_FLAG_IN_PLACE root block is left in place and dst_buffer
+   of the root is not accessed. src_buffer of non-root ranks is not
+   accessed. */
+ucc_status_t ucc_tl_ucp_scatter_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_scatter_knomial_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_scatter_linear_init(ucc_tl_ucp_task_t *task);
+
+#endif
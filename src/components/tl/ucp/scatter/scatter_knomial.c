@@ -0,0 +1,216 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/knomial_tree.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial scatter, the mirror of the knomial gather: every rank receives
+   the blocks of its whole subtree in vrank order as a single message and
+   forwards the subranges of the children, largest subtrees first. Root
+   sends right from src if it is rank 0, otherwise src is rotated into
+   vrank order in scratch first. */
+enum {
+    PHASE_INIT,
+    PHASE_RECV, /* recv from the parent */
+    PHASE_SEND, /* send to the children */
+};
+
+#define CHECK_PHASE(_p)                                                        \
+    case _p:                                                                   \
+        goto _p;                                                               \
+        break;
+
+#define GOTO_PHASE(_phase)                                                     \
+    do {                                                                       \
+        switch (_phase) {                                                      \
+            CHECK_PHASE(PHASE_RECV);                                           \
+            CHECK_PHASE(PHASE_SEND);                                           \
+        case PHASE_INIT:                                                       \
+            break;                                                             \
+        };                                                                     \
+    } while (0)
+
+#define SAVE_STATE(_phase)                                                     \
+    do {                                                                       \
+        task->scatter_kn.phase = _phase;                                       \
+    } while (0)
+
+/* Buffer holding the subtree blocks */
+static inline void *scatter_kn_buf(ucc_tl_ucp_task_t *task, int vrank)
+{
+    if (task->scatter_kn.scratch) {
+        return task->scatter_kn.scratch;
+    }
+    return (0 == vrank) ? task->args.buffer_info.src_buffer
+                        : task->args.buffer_info.dst_buffer;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                size       = team->size;
+    int                root       = (int)task->args.root;
+    int                radix      = task->scatter_kn.radix;
+    int                vrank      = KN_TREE_VRANK(team->rank, root, size);
+    ucc_memory_type_t  mem_type   = task->scatter_kn.mem_type;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    void              *buf        = scatter_kn_buf(task, vrank);
+    int                level, radix_pow, k, child, n_blocks;
+    ucc_status_t       status;
+
+    level = ucc_kn_tree_level(vrank, radix, size);
+    GOTO_PHASE(task->scatter_kn.phase);
+
+    if (0 != vrank) {
+        ucc_tl_ucp_recv_nb(
+            buf, ucc_min(level, size - vrank) * block_size, mem_type,
+            KN_TREE_RANK(KN_TREE_PARENT(vrank, radix, level), root, size),
+            team, task);
+    }
+PHASE_RECV:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_RECV);
+        return UCC_INPROGRESS;
+    }
+    for (radix_pow = level / radix; radix_pow > 0; radix_pow /= radix) {
+        for (k = 1; k < radix; k++) {
+            child = vrank + k * radix_pow;
+            if (child >= size) {
+                break;
+            }
+            n_blocks = ucc_min(radix_pow, size - child);
+            ucc_tl_ucp_send_nb(
+                (void *)((ptrdiff_t)buf + (child - vrank) * block_size),
+                n_blocks * block_size, mem_type,
+                KN_TREE_RANK(child, root, size), team, task);
+        }
+    }
+    if (0 != vrank && buf != task->args.buffer_info.dst_buffer) {
+        /* own block is the first one of the subtree */
+        status = ucc_mc_memcpy(task->args.buffer_info.dst_buffer, buf,
+                               block_size, mem_type, mem_type);
+        if (UCC_OK != status) {
+            task->super.super.status = status;
+            return status;
+        }
+    }
+PHASE_SEND:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(PHASE_SEND);
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team     = task->team;
+    int                size     = team->size;
+    int                root     = (int)task->args.root;
+    ucc_memory_type_t  mem_type = task->scatter_kn.mem_type;
+    void              *sbuf     = task->args.buffer_info.src_buffer;
+    size_t             block_size;
+    ucc_status_t       status   = UCC_OK;
+
+    task->scatter_kn.phase   = PHASE_INIT;
+    task->super.super.status = UCC_INPROGRESS;
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->rank == root) {
+        if (!UCC_IS_INPLACE(task->args)) {
+            status = ucc_mc_memcpy(
+                task->args.buffer_info.dst_buffer,
+                (void *)((ptrdiff_t)sbuf + root * block_size), block_size,
+                mem_type, mem_type);
+        }
+        /* vrank j is rank (j + root) % size */
+        if (UCC_OK == status && task->scatter_kn.scratch) {
+            status = ucc_mc_memcpy(
+                task->scatter_kn.scratch,
+                (void *)((ptrdiff_t)sbuf + root * block_size),
+                (size - root) * block_size, mem_type, mem_type);
+        }
+        if (UCC_OK == status && task->scatter_kn.scratch) {
+            status = ucc_mc_memcpy(
+                (void *)((ptrdiff_t)task->scatter_kn.scratch +
+                         (size - root) * block_size),
+                sbuf, root * block_size, mem_type, mem_type);
+        }
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_scatter_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (task->scatter_kn.scratch) {
+        ucc_mc_free(task->scatter_kn.scratch, task->scatter_kn.mem_type);
+    }
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_scatter_knomial_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team  = task->team;
+    int                size  = team->size;
+    int                root  = (int)task->args.root;
+    int                vrank = KN_TREE_VRANK(team->rank, root, size);
+    size_t block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int          radix, n_blocks;
+    ucc_status_t status;
+
+    radix = ucc_min(UCC_TL_UCP_TEAM_CTX(team)->cfg.scatter_kn_radix, size);
+    if (radix < 2) {
+        radix = 2;
+    }
+    task->scatter_kn.radix   = radix;
+    task->scatter_kn.scratch = NULL;
+    status = ucc_mc_type((0 == vrank) ? task->args.buffer_info.src_buffer
+                                      : task->args.buffer_info.dst_buffer,
+                         &task->scatter_kn.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    /* leaves receive right into dst, root 0 sends from src */
+    n_blocks = ucc_min(ucc_kn_tree_level(vrank, radix, size), size - vrank);
+    if ((0 == vrank && 0 != root) || (0 != vrank && n_blocks > 1)) {
+        status = ucc_mc_alloc(&task->scatter_kn.scratch,
+                              ucc_max(n_blocks * block_size, 1),
+                              task->scatter_kn.mem_type);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate scratch for scatter");
+            return status;
+        }
+    }
+    task->super.post     = ucc_tl_ucp_scatter_knomial_start;
+    task->super.progress = ucc_tl_ucp_scatter_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_scatter_knomial_finalize;
+    return UCC_OK;
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Linear scatter for large blocks: root sends every block directly to its
+   destination keeping at most n_posts sends outstanding. */
+
+ucc_status_t ucc_tl_ucp_scatter_linear_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = task->team;
+    int                size       = team->size;
+    int                root       = (int)task->args.root;
+    void              *sbuf       = task->args.buffer_info.src_buffer;
+    size_t             block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                        ucc_dt_size(task->args.buffer_info.src_datatype);
+    int                polls      = 0;
+    int                peer;
+
+    if (team->rank == root) {
+        while (task->scatter_linear.step < size) {
+            while (task->scatter_linear.step < size &&
+                   task->send_posted - task->send_completed <
+                       task->scatter_linear.n_posts) {
+                peer = (root + task->scatter_linear.step) % size;
+                ucc_tl_ucp_send_nb((void *)((ptrdiff_t)sbuf +
+                                            peer * block_size),
+                                   block_size, task->scatter_linear.mem_type,
+                                   peer, team, task);
+                task->scatter_linear.step++;
+            }
+            if (task->scatter_linear.step == size) {
+                break;
+            }
+            if (polls++ >= task->n_polls) {
+                return UCC_INPROGRESS;
+            }
+            ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+        }
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return UCC_INPROGRESS;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_linear_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = task->team;
+    int                root = (int)task->args.root;
+    size_t             block_size;
+    ucc_status_t       status;
+
+    task->scatter_linear.step = 1;
+    task->super.super.status  = UCC_INPROGRESS;
+    block_size = UCC_COLL_ARGS_COUNT(task->args) *
+                 ucc_dt_size(task->args.buffer_info.src_datatype);
+    if (team->rank != root) {
+        ucc_tl_ucp_recv_nb(task->args.buffer_info.dst_buffer, block_size,
+                           task->scatter_linear.mem_type, root, team, task);
+    } else if (!UCC_IS_INPLACE(task->args)) {
+        status = ucc_mc_memcpy(
+            task->args.buffer_info.dst_buffer,
+            (void *)((ptrdiff_t)task->args.buffer_info.src_buffer +
+                     root * block_size),
+            block_size, task->scatter_linear.mem_type,
+            task->scatter_linear.mem_type);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_scatter_linear_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_UCP_TEAM_CORE_CTX(team)->pq, &task->super);
+    } else if (status < 0) {
+        return status;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_linear_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = task->team;
+    ucc_status_t       status;
+
+    task->scatter_linear.n_posts =
+        ucc_max(UCC_TL_UCP_TEAM_CTX(team)->cfg.scatter_linear_num_posts, 1);
+    status = ucc_mc_type((team->rank == task->args.root)
+                             ? task->args.buffer_info.src_buffer
+                             : task->args.buffer_info.dst_buffer,
+                         &task->scatter_linear.mem_type);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->super.post     = ucc_tl_ucp_scatter_linear_start;
+    task->super.progress = ucc_tl_ucp_scatter_linear_progress;
+    return UCC_OK;
+}
@@ -35,10 +35,201 @@ static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
      UCC_CONFIG_TYPE_UINT},
 
     {"BARRIER_KN_RADIX", "4",
-     "Radix of the recursive-knomial barrier algorithm",
+     "Radix of the recursive-knomial and dissemination barrier algorithms",
      ucc_offsetof(ucc_tl_ucp_context_config_t, kn_barrier_radix),
      UCC_CONFIG_TYPE_UINT},
 
+    {"ALLREDUCE_KN_RADIX", "4",
+     "Radix of the recursive-knomial allreduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLREDUCE_SRA_KN_RADIX", "4",
+     "Radix of the scatter-reduce-allgather (SRA) knomial allreduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_sra_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLREDUCE_SRA_KN_THRESH", "64k",
+     "Message size starting from which the SRA knomial allreduce algorithm "
+     "is used instead of the recursive-knomial one",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_sra_kn_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_RING_THRESH", "4m",
+     "Message size starting from which the pipelined ring allreduce "
+     "algorithm is used",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_ring_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_RING_FRAG_SIZE", "256k",
+     "Maximum size of the fragment the ring allreduce pipeline operates on",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_ring_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_RING_N_FRAGS", "4",
+     "Maximum number of fragments in flight in the ring allreduce pipeline",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_ring_n_frags),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLREDUCE_DBT_THRESH", "64k",
+     "Message size starting from which the double binary tree allreduce "
+     "algorithm is used on large teams (see ALLREDUCE_DBT_MIN_TEAM_SIZE)",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_dbt_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_DBT_MIN_TEAM_SIZE", "512",
+     "Minimal team size for the double binary tree allreduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_dbt_min_team_size),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLREDUCE_DBT_FRAG_SIZE", "64k",
+     "Maximum size of the fragment the double binary tree allreduce "
+     "pipeline operates on",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_dbt_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_DBT_N_FRAGS", "4",
+     "Maximum number of fragments in flight per tree in the double binary "
+     "tree allreduce pipeline",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allreduce_dbt_n_frags),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"BCAST_KN_RADIX", "4",
+     "Radix of the knomial tree bcast algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"BCAST_SAG_THRESH", "256k",
+     "Message size starting from which the scatter-allgather bcast algorithm "
+     "(knomial scatter followed by ring allgather) is used",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_sag_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"BCAST_CHAIN_THRESH", "8m",
+     "Message size starting from which the pipelined chain bcast algorithm "
+     "is used",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_chain_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"BCAST_CHAIN_FRAG_SIZE", "128k",
+     "Size of the fragment the chain bcast pipeline operates on",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_chain_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"BCAST_CHAIN_N_FRAGS", "8",
+     "Maximum number of fragments in flight in the chain bcast pipeline",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_chain_n_frags),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"BCAST_CHAIN_MAX_TEAM_SIZE", "32",
+     "Maximal team size for the pipelined chain bcast algorithm: the chain "
+     "adds a fragment latency per rank, on larger teams scatter-allgather "
+     "is faster",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, bcast_chain_max_team_size),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_KN_RADIX", "4",
+     "Radix of the knomial tree reduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, reduce_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLGATHER_RING_THRESH", "1k",
+     "Per rank message size starting from which the ring allgather algorithm "
+     "is used, smaller messages use recursive doubling (power of two teams) "
+     "or Bruck algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allgather_ring_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLTOALL_PAIRWISE_NUM_POSTS", "8",
+     "Maximum number of outstanding sends and receives of the pairwise "
+     "alltoall and alltoallv algorithms",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, alltoall_pairwise_num_posts),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLTOALL_BRUCK_THRESH", "128",
+     "Per peer message size below which the Bruck alltoall algorithm is used "
+     "instead of the pairwise exchange",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, alltoall_bruck_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"GATHER_KN_RADIX", "4",
+     "Radix of the knomial tree gather algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, gather_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"GATHER_LINEAR_THRESH", "64k",
+     "Per rank message size starting from which the linear gather algorithm "
+     "is used instead of the knomial tree",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, gather_linear_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"GATHER_LINEAR_NUM_POSTS", "16",
+     "Maximum number of outstanding receives on the root in the linear "
+     "gather and gatherv algorithms",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, gather_linear_num_posts),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"SCATTER_KN_RADIX", "4",
+     "Radix of the knomial tree scatter algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, scatter_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"SCATTER_LINEAR_THRESH", "64k",
+     "Per rank message size starting from which the linear scatter algorithm "
+     "is used instead of the knomial tree",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, scatter_linear_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"SCATTER_LINEAR_NUM_POSTS", "16",
+     "Maximum number of outstanding sends on the root in the linear "
+     "scatter algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, scatter_linear_num_posts),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"FANIN_KN_RADIX", "4",
+     "Radix of the knomial tree fanin algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, fanin_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"FANOUT_KN_RADIX", "4",
+     "Radix of the knomial tree fanout algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, fanout_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_SCATTER_RING_THRESH", "256k",
+     "Per rank message size starting from which the ring reduce_scatter "
+     "algorithm is used for power of two teams, smaller messages use "
+     "recursive halving. Other teams always use the ring",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, reduce_scatter_ring_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLGATHERV_KN_RADIX", "4",
+     "Radix of the knomial tree allgatherv algorithm",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allgatherv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLGATHERV_RING_THRESH", "1k",
+     "Average per rank message size starting from which the ring allgatherv "
+     "algorithm is used, smaller messages use the knomial tree",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, allgatherv_ring_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"PIPELINE_THRESH", "inf",
+     "Message size starting from which bcast, reduce and allreduce are split "
+     "into fragments, each fragment runs the algorithm selected for its size",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, pipeline_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"PIPELINE_FRAG_SIZE", "1m",
+     "Size of the fragment of the pipelined collectives",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, pipeline_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"PIPELINE_N_FRAGS", "2",
+     "Maximum number of fragments of the pipelined collectives in flight",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, pipeline_n_frags),
+     UCC_CONFIG_TYPE_UINT},
+
     {"OOB_NPOLLS", "20",
      "Number of polling cycles for oob allgather request",
      ucc_offsetof(ucc_tl_ucp_context_config_t, oob_npolls),
@@ -29,6 +29,40 @@ typedef struct ucc_tl_ucp_context_config {
     uint32_t                n_polls;
     uint32_t                oob_npolls;
     uint32_t                kn_barrier_radix;
+    uint32_t                allreduce_kn_radix;
+    uint32_t                allreduce_sra_kn_radix;
+    size_t                  allreduce_sra_kn_thresh;
+    size_t                  allreduce_ring_thresh;
+    size_t                  allreduce_ring_frag_size;
+    uint32_t                allreduce_ring_n_frags;
+    size_t                  allreduce_dbt_thresh;
+    uint32_t                allreduce_dbt_min_team_size;
+    size_t                  allreduce_dbt_frag_size;
+    uint32_t                allreduce_dbt_n_frags;
+    uint32_t                bcast_kn_radix;
+    size_t                  bcast_sag_thresh;
+    size_t                  bcast_chain_thresh;
+    size_t                  bcast_chain_frag_size;
+    uint32_t                bcast_chain_n_frags;
+    uint32_t                bcast_chain_max_team_size;
+    uint32_t                reduce_kn_radix;
+    size_t                  allgather_ring_thresh;
+    uint32_t                alltoall_pairwise_num_posts;
+    size_t                  alltoall_bruck_thresh;
+    uint32_t                gather_kn_radix;
+    size_t                  gather_linear_thresh;
+    uint32_t                gather_linear_num_posts;
+    uint32_t                scatter_kn_radix;
+    size_t                  scatter_linear_thresh;
+    uint32_t                scatter_linear_num_posts;
+    uint32_t                fanin_kn_radix;
+    uint32_t                fanout_kn_radix;
+    size_t                  reduce_scatter_ring_thresh;
+    uint32_t                allgatherv_kn_radix;
+    size_t                  allgatherv_ring_thresh;
+    size_t                  pipeline_thresh;
+    size_t                  pipeline_frag_size;
+    uint32_t                pipeline_n_frags;
 } ucc_tl_ucp_context_config_t;
 
 typedef struct ucc_tl_ucp_lib {
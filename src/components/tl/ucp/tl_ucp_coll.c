@@ -7,7 +7,24 @@
 #include "tl_ucp.h"
 #include "tl_ucp_coll.h"
 #include "tl_ucp_tag.h"
+#include "tl_ucp_sendrecv.h"
 #include "barrier/barrier.h"
+#include "allreduce/allreduce.h"
+#include "bcast/bcast.h"
+#include "reduce/reduce.h"
+#include "allgather/allgather.h"
+#include "alltoall/alltoall.h"
+#include "alltoallv/alltoallv.h"
+#include "gather/gather.h"
+#include "scatter/scatter.h"
+#include "fanin/fanin.h"
+#include "fanout/fanout.h"
+#include "reduce_scatter/reduce_scatter.h"
+#include "scan/scan.h"
+#include "allgatherv/allgatherv.h"
+#include "gatherv/gatherv.h"
+#include "schedule/ucc_schedule_pipelined.h"
+#include "utils/ucc_coll_utils.h"
 
 void ucc_tl_ucp_send_completion_cb(void *request, ucs_status_t status,
                                    void *user_data)
@@ -36,7 +53,17 @@ void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
     ucp_request_free(request);
 }
 
-static ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task)
+void ucc_tl_ucp_frag_recv_completion_cb(void *request, ucs_status_t status,
+                                        const ucp_tag_recv_info_t *info,
+                                        void *user_data)
+{
+    ucc_tl_ucp_frag_slot_t *slot = (ucc_tl_ucp_frag_slot_t *)user_data;
+
+    slot->completed++;
+    ucc_tl_ucp_recv_completion_cb(request, status, info, slot->task);
+}
+
+ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task)
 {
     ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
     tl_info(task->team->super.super.context->lib, "finalizing coll task %p",
@@ -45,9 +72,9 @@ static ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task)
     return UCC_OK;
 }
 
-ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_op_args_t *coll_args,
-                                  ucc_base_team_t *team,
-                                  ucc_coll_task_t **task_h)
+static ucc_status_t ucc_tl_ucp_task_init(ucc_base_coll_op_args_t *coll_args,
+                                         ucc_base_team_t *team,
+                                         ucc_coll_task_t **task_h)
 {
     ucc_tl_ucp_team_t    *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
     ucc_tl_ucp_context_t *ctx     = UCC_TL_UCP_TEAM_CTX(tl_team);
@@ -63,11 +90,148 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_op_args_t *coll_args,
     case UCC_COLL_TYPE_BARRIER:
         status = ucc_tl_ucp_barrier_init(task);
         break;
+    case UCC_COLL_TYPE_ALLREDUCE:
+        status = ucc_tl_ucp_allreduce_init(task);
+        break;
+    case UCC_COLL_TYPE_BCAST:
+        status = ucc_tl_ucp_bcast_init(task);
+        break;
+    case UCC_COLL_TYPE_REDUCE:
+        status = ucc_tl_ucp_reduce_init(task);
+        break;
+    case UCC_COLL_TYPE_ALLGATHER:
+        status = ucc_tl_ucp_allgather_init(task);
+        break;
+    case UCC_COLL_TYPE_ALLTOALL:
+        status = ucc_tl_ucp_alltoall_init(task);
+        break;
+    case UCC_COLL_TYPE_ALLTOALLV:
+        status = ucc_tl_ucp_alltoallv_init(task);
+        break;
+    case UCC_COLL_TYPE_GATHER:
+        status = ucc_tl_ucp_gather_init(task);
+        break;
+    case UCC_COLL_TYPE_SCATTER:
+        status = ucc_tl_ucp_scatter_init(task);
+        break;
+    case UCC_COLL_TYPE_FANIN:
+        status = ucc_tl_ucp_fanin_init(task);
+        break;
+    case UCC_COLL_TYPE_FANOUT:
+        status = ucc_tl_ucp_fanout_init(task);
+        break;
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        status = ucc_tl_ucp_reduce_scatter_init(task);
+        break;
+    case UCC_COLL_TYPE_SCAN:
+    case UCC_COLL_TYPE_EXSCAN:
+        status = ucc_tl_ucp_scan_init(task);
+        break;
+    case UCC_COLL_TYPE_ALLGATHERV:
+        status = ucc_tl_ucp_allgatherv_init(task);
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        status = ucc_tl_ucp_gatherv_init(task);
+        break;
     default:
         ucc_tl_ucp_put_task(task);
         return UCC_ERR_NOT_SUPPORTED;
     }
+    if (UCC_OK != status) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
     tl_info(team->context->lib, "init coll req %p", task);
     *task_h = &task->super;
     return status;
 }
+
+/* Fragment f of the pipelined collective: src and dst are shifted by the
+   fragment offset, the count is set by the schedule */
+static ucc_status_t ucc_tl_ucp_frag_setup(ucc_schedule_pipelined_t *schedule,
+                                          ucc_coll_task_t *frag, int frag_num)
+{
+    ucc_tl_ucp_task_t      *task = ucc_derived_of(frag, ucc_tl_ucp_task_t);
+    ucc_coll_buffer_info_t *bi   = &schedule->args.buffer_info;
+    size_t                  offset;
+
+    offset = ucc_schedule_pipelined_frag_offset(schedule, frag_num) *
+             ucc_dt_size(bi->src_datatype);
+    if (bi->src_buffer) {
+        task->args.buffer_info.src_buffer =
+            (void *)((ptrdiff_t)bi->src_buffer + offset);
+    }
+    if (bi->dst_buffer) {
+        task->args.buffer_info.dst_buffer =
+            (void *)((ptrdiff_t)bi->dst_buffer + offset);
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t              status;
+
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_free(schedule);
+    return status;
+}
+
+static int ucc_tl_ucp_coll_pipelined(ucc_base_coll_op_args_t *coll_args,
+                                     ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_context_config_t *cfg = &UCC_TL_UCP_TEAM_CTX(team)->cfg;
+    size_t                       msgsize;
+
+    switch (coll_args->args.coll_type) {
+    case UCC_COLL_TYPE_BCAST:
+    case UCC_COLL_TYPE_REDUCE:
+    case UCC_COLL_TYPE_ALLREDUCE:
+        break;
+    default:
+        return 0;
+    }
+    if (team->size < 2) {
+        return 0;
+    }
+    msgsize = UCC_COLL_ARGS_COUNT(coll_args->args) *
+              ucc_dt_size(coll_args->args.buffer_info.src_datatype);
+    return msgsize >= cfg->pipeline_thresh &&
+           msgsize > cfg->pipeline_frag_size;
+}
+
+ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_op_args_t *coll_args,
+                                  ucc_base_team_t *team,
+                                  ucc_coll_task_t **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_context_t     *ctx     = UCC_TL_UCP_TEAM_CTX(tl_team);
+    ucc_schedule_pipelined_t *schedule;
+    ucc_status_t              status;
+
+    if (!ucc_tl_ucp_coll_pipelined(coll_args, tl_team)) {
+        return ucc_tl_ucp_task_init(coll_args, team, task_h);
+    }
+    schedule = ucc_malloc(sizeof(*schedule), "tl_ucp_pipelined");
+    if (!schedule) {
+        tl_error(team->context->lib,
+                 "failed to allocate %zd bytes for pipelined schedule",
+                 sizeof(*schedule));
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_tl_ucp_task_init, ucc_tl_ucp_frag_setup,
+        ctx->cfg.pipeline_frag_size, ctx->cfg.pipeline_n_frags,
+        UCC_TL_UCP_TEAM_CORE_CTX(tl_team), schedule);
+    if (UCC_OK != status) {
+        ucc_free(schedule);
+        return status;
+    }
+    schedule->super.super.finalize = ucc_tl_ucp_pipelined_finalize;
+    tl_info(team->context->lib, "init pipelined coll req %p, n_frags %d",
+            schedule, schedule->n_frags_total);
+    *task_h = &schedule->super.super;
+    return UCC_OK;
+}
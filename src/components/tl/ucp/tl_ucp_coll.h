@@ -8,7 +8,18 @@
 #define UCC_TL_UCP_COLL_H_
 #include "tl_ucp.h"
 #include "schedule/ucc_schedule.h"
-typedef struct ucc_tl_ucp_task {
+#include "components/mc/base/ucc_mc_base.h"
+
+typedef struct ucc_tl_ucp_task ucc_tl_ucp_task_t;
+
+/* Receive completion tracking for the pipelined algorithms, which need to
+   know which particular fragment has arrived, see ucc_tl_ucp_recv_frag_nb */
+typedef struct ucc_tl_ucp_frag_slot {
+    ucc_tl_ucp_task_t *task;
+    int                completed; /* number of completed receives */
+} ucc_tl_ucp_frag_slot_t;
+
+struct ucc_tl_ucp_task {
     ucc_coll_task_t    super;
     ucc_coll_op_args_t args;
     ucc_tl_ucp_team_t *team;
@@ -25,8 +36,168 @@ typedef struct ucc_tl_ucp_task {
             int radix_mask_pow;
             int radix;
         } barrier;
+        struct {
+            int               phase;
+            int               iteration;
+            int               radix_mask_pow;
+            int               radix;
+            size_t            count;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } allreduce_kn;
+        struct {
+            int                     phase;
+            size_t                  count;
+            void                   *scratch;
+            ucc_memory_type_t       mem_type;
+            size_t                  frag_count;
+            int                     n_frags;
+            int                     max_inflight;
+            int                     n_ops;
+            int                     recvs_posted;
+            int                     sends_posted;
+            int                     processed;
+            ucc_tl_ucp_frag_slot_t *frags;
+        } allreduce_ring;
+        struct {
+            int                                   phase;
+            size_t                                count;
+            void                                 *scratch;
+            ucc_memory_type_t                     mem_type;
+            size_t                                frag_count;
+            int                                   max_inflight;
+            struct ucc_tl_ucp_allreduce_dbt_tree *trees;
+        } allreduce_dbt;
+        struct {
+            int               phase;
+            int               radix;
+            ucc_memory_type_t mem_type;
+        } bcast_kn;
+        struct {
+            int               phase;
+            int               radix;
+            int               step;
+            ucc_memory_type_t mem_type;
+        } bcast_sag;
+        struct {
+            int                     phase;
+            ucc_memory_type_t       mem_type;
+            size_t                  frag_count;
+            int                     n_frags;
+            int                     max_inflight;
+            int                     recvs_posted;
+            int                     processed;
+            ucc_tl_ucp_frag_slot_t *frags;
+        } bcast_chain;
+        struct {
+            int               phase;
+            int               radix;
+            int               radix_pow;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } reduce_kn;
+        struct {
+            int               phase;
+            int               step;
+            ucc_memory_type_t mem_type;
+        } allgather_ring;
+        struct {
+            int               phase;
+            int               dist;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } allgather_bruck;
+        struct {
+            int               phase;
+            int               dist;
+            ucc_memory_type_t mem_type;
+        } allgather_rd;
+        struct {
+            uint32_t          n_posts;
+            ucc_memory_type_t src_mem_type;
+            ucc_memory_type_t dst_mem_type;
+        } alltoall_pairwise;
+        struct {
+            int               phase;
+            int               dist;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+            ucc_memory_type_t src_mem_type;
+            ucc_memory_type_t dst_mem_type;
+        } alltoall_bruck;
+        struct {
+            int               step;
+            uint32_t          n_posts;
+            ucc_memory_type_t src_mem_type;
+            ucc_memory_type_t dst_mem_type;
+        } alltoallv_pairwise;
+        struct {
+            int               phase;
+            int               radix;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } gather_kn;
+        struct {
+            int               step;
+            uint32_t          n_posts;
+            ucc_memory_type_t mem_type;
+        } gather_linear;
+        struct {
+            int               phase;
+            int               radix;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } scatter_kn;
+        struct {
+            int               step;
+            uint32_t          n_posts;
+            ucc_memory_type_t mem_type;
+        } scatter_linear;
+        struct {
+            int phase;
+            int radix;
+        } fanin_kn;
+        struct {
+            int phase;
+            int radix;
+        } fanout_kn;
+        struct {
+            int               phase;
+            int               step;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } reduce_scatter_ring;
+        struct {
+            int               phase;
+            int               dist;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } reduce_scatter_rh;
+        struct {
+            int               phase;
+            int               dist;
+            void             *scratch;
+            ucc_memory_type_t mem_type;
+        } scan_rd;
+        struct {
+            int               phase;
+            int               step;
+            ucc_memory_type_t mem_type;
+        } allgatherv_ring;
+        struct {
+            int               phase;
+            int               radix;
+            ucc_memory_type_t mem_type;
+            ucp_dt_iov_t     *iov;    /* blocks of the messages in flight */
+            int               n_iov;
+        } allgatherv_kn;
+        struct {
+            int               step;
+            uint32_t          n_posts;
+            ucc_memory_type_t mem_type;
+        } gatherv_linear;
     };
-} ucc_tl_ucp_task_t;
+};
 
 static inline ucc_tl_ucp_task_t *ucc_tl_ucp_get_task(ucc_tl_ucp_context_t *ctx)
 {
@@ -45,6 +216,8 @@ static inline void ucc_tl_ucp_put_task(ucc_tl_ucp_task_t *task)
     ucc_mpool_put(task);
 }
 
+ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task);
+
 #define UCC_TL_UCP_TASK_P2P_COMPLETE(_task)                                    \
     (((_task)->send_posted == (_task)->send_completed) &&                      \
      ((_task)->recv_posted == (_task)->recv_completed))
@@ -19,6 +19,9 @@ void ucc_tl_ucp_send_completion_cb(void *request, ucs_status_t status,
 void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
                                    const ucp_tag_recv_info_t *info,
                                    void *user_data);
+void ucc_tl_ucp_frag_recv_completion_cb(void *request, ucs_status_t status,
+                                        const ucp_tag_recv_info_t *info,
+                                        void *user_data);
 
 #define UCC_TL_UCP_MAKE_TAG(_tag, _rank, _id, _scope_id, _scope)       \
     ((((uint64_t) (_tag))      << UCC_TL_UCP_TAG_BITS_OFFSET)      |   \
@@ -54,11 +57,12 @@ void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
         }                                                                      \
     } while (0)
 
-static inline ucc_status_t ucc_tl_ucp_send_nb(void *buffer, size_t msglen,
-                                              ucc_memory_type_t mtype,
-                                              int               dest_group_rank,
-                                              ucc_tl_ucp_team_t *team,
-                                              ucc_tl_ucp_task_t *task)
+/* Sends count elements of the ucp datatype, e.g. an array of ucp_dt_iov_t
+   entries for ucp_dt_make_iov() */
+static inline ucc_status_t
+ucc_tl_ucp_send_dt_nb(void *buffer, size_t count, ucp_datatype_t datatype,
+                      ucc_memory_type_t mtype, int dest_group_rank,
+                      ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task)
 {
     ucp_request_param_t req_param;
     ucs_status_ptr_t    ucp_status;
@@ -75,11 +79,11 @@ static inline ucc_status_t ucc_tl_ucp_send_nb(void *buffer, size_t msglen,
     req_param.op_attr_mask =
         UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_DATATYPE |
         UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FIELD_MEMORY_TYPE;
-    req_param.datatype    = ucp_dt_make_contig(msglen);
+    req_param.datatype    = datatype;
     req_param.cb.send     = ucc_tl_ucp_send_completion_cb;
     req_param.memory_type = ucc_memtype_to_ucs[mtype];
     req_param.user_data   = (void *)task;
-    ucp_status = ucp_tag_send_nbx(ep, buffer, 1, ucp_tag, &req_param);
+    ucp_status = ucp_tag_send_nbx(ep, buffer, count, ucp_tag, &req_param);
     task->send_posted++;
     if (UCC_OK != ucp_status) {
         UCC_TL_UCP_CHECK_REQ_STATUS();
@@ -89,11 +93,37 @@ static inline ucc_status_t ucc_tl_ucp_send_nb(void *buffer, size_t msglen,
     return UCC_OK;
 }
 
-static inline ucc_status_t ucc_tl_ucp_recv_nb(void *buffer, size_t msglen,
+static inline ucc_status_t ucc_tl_ucp_send_nb(void *buffer, size_t msglen,
                                               ucc_memory_type_t mtype,
                                               int               dest_group_rank,
                                               ucc_tl_ucp_team_t *team,
                                               ucc_tl_ucp_task_t *task)
+{
+    return ucc_tl_ucp_send_dt_nb(buffer, 1, ucp_dt_make_contig(msglen), mtype,
+                                 dest_group_rank, team, task);
+}
+
+/* Sends the iov_cnt buffers of iov as one message, iov must stay valid
+   until the send completes */
+static inline ucc_status_t
+ucc_tl_ucp_send_iov_nb(ucp_dt_iov_t *iov, size_t iov_cnt,
+                       ucc_memory_type_t mtype, int dest_group_rank,
+                       ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task)
+{
+    return ucc_tl_ucp_send_dt_nb(iov, iov_cnt, ucp_dt_make_iov(), mtype,
+                                 dest_group_rank, team, task);
+}
+
+/* Posts receive with the user provided completion callback. The callback
+   receives "user_data" and is responsible for updating task recv counters
+   (typically by calling ucc_tl_ucp_recv_completion_cb). Returns UCC_OK if
+   the receive completed immediately (callback is not called then) and
+   UCC_INPROGRESS otherwise. */
+static inline ucc_status_t
+ucc_tl_ucp_recv_dt_cb(void *buffer, size_t count, ucp_datatype_t datatype,
+                      ucc_memory_type_t mtype, int dest_group_rank,
+                      ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task,
+                      ucp_tag_recv_nbx_callback_t cb, void *user_data)
 {
     ucp_request_param_t req_param;
     ucs_status_ptr_t    ucp_status;
@@ -104,19 +134,76 @@ static inline ucc_status_t ucc_tl_ucp_recv_nb(void *buffer, size_t msglen,
     req_param.op_attr_mask =
         UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_DATATYPE |
         UCP_OP_ATTR_FIELD_USER_DATA | UCP_OP_ATTR_FIELD_MEMORY_TYPE;
-    req_param.datatype    = ucp_dt_make_contig(msglen);
-    req_param.cb.recv     = ucc_tl_ucp_recv_completion_cb;
+    req_param.datatype    = datatype;
+    req_param.cb.recv     = cb;
     req_param.memory_type = ucc_memtype_to_ucs[mtype];
-    req_param.user_data   = (void *)task;
-    ucp_status = ucp_tag_recv_nbx(UCC_TL_UCP_WORKER(team), buffer, 1, ucp_tag,
-                                  ucp_tag_mask, &req_param);
+    req_param.user_data   = user_data;
+    ucp_status = ucp_tag_recv_nbx(UCC_TL_UCP_WORKER(team), buffer, count,
+                                  ucp_tag, ucp_tag_mask, &req_param);
     task->recv_posted++;
     if (UCC_OK != ucp_status) {
         UCC_TL_UCP_CHECK_REQ_STATUS();
-    } else {
-        task->recv_completed++;
+        return UCC_INPROGRESS;
     }
+    task->recv_completed++;
     return UCC_OK;
 }
 
+static inline ucc_status_t
+ucc_tl_ucp_recv_cb(void *buffer, size_t msglen, ucc_memory_type_t mtype,
+                   int dest_group_rank, ucc_tl_ucp_team_t *team,
+                   ucc_tl_ucp_task_t *task, ucp_tag_recv_nbx_callback_t cb,
+                   void *user_data)
+{
+    return ucc_tl_ucp_recv_dt_cb(buffer, 1, ucp_dt_make_contig(msglen), mtype,
+                                 dest_group_rank, team, task, cb, user_data);
+}
+
+static inline ucc_status_t ucc_tl_ucp_recv_nb(void *buffer, size_t msglen,
+                                              ucc_memory_type_t mtype,
+                                              int               dest_group_rank,
+                                              ucc_tl_ucp_team_t *team,
+                                              ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    status = ucc_tl_ucp_recv_cb(buffer, msglen, mtype, dest_group_rank, team,
+                                task, ucc_tl_ucp_recv_completion_cb,
+                                (void *)task);
+    return (UCC_INPROGRESS == status) ? UCC_OK : status;
+}
+
+/* Receives one message into the iov_cnt buffers of iov, iov must stay
+   valid until the receive completes */
+static inline ucc_status_t
+ucc_tl_ucp_recv_iov_nb(ucp_dt_iov_t *iov, size_t iov_cnt,
+                       ucc_memory_type_t mtype, int dest_group_rank,
+                       ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    status = ucc_tl_ucp_recv_dt_cb(iov, iov_cnt, ucp_dt_make_iov(), mtype,
+                                   dest_group_rank, team, task,
+                                   ucc_tl_ucp_recv_completion_cb,
+                                   (void *)task);
+    return (UCC_INPROGRESS == status) ? UCC_OK : status;
+}
+
+/* Receive that additionally increments slot->completed on completion */
+static inline ucc_status_t
+ucc_tl_ucp_recv_frag_nb(void *buffer, size_t msglen, ucc_memory_type_t mtype,
+                        int dest_group_rank, ucc_tl_ucp_team_t *team,
+                        ucc_tl_ucp_task_t *task, ucc_tl_ucp_frag_slot_t *slot)
+{
+    ucc_status_t status;
+
+    status = ucc_tl_ucp_recv_cb(buffer, msglen, mtype, dest_group_rank, team,
+                                task, ucc_tl_ucp_frag_recv_completion_cb,
+                                (void *)slot);
+    if (UCC_OK == status) {
+        slot->completed++;
+    }
+    return (UCC_INPROGRESS == status) ? UCC_OK : status;
+}
+
 #endif
@@ -21,23 +21,65 @@ static ucc_cl_team_t *ucc_select_cl_team(ucc_coll_op_args_t *coll_args,
     return team->cl_teams[0];
 }
 
-ucc_status_t ucc_collective_init(ucc_coll_op_args_t *coll_args,
-                                 ucc_coll_req_h *request, ucc_team_h team)
+/* The base args wrap the user args only, so they are passed down as is:
+   the TL makes the single copy into the task */
+static inline ucc_status_t ucc_coll_init(ucc_coll_op_args_t *coll_args,
+                                         ucc_team_t *team,
+                                         ucc_coll_task_t **task)
 {
-    ucc_cl_team_t          *cl_team;
-    ucc_base_coll_op_args_t op_args;
-    ucc_status_t            status;
-    ucc_coll_task_t        *task;
-    /* TO discuss: maybe we want to pass around user pointer ? */
-    memcpy(&op_args.args, coll_args, sizeof(ucc_coll_op_args_t));
+    ucc_cl_team_t *cl_team;
+    ucc_status_t   status;
+
+    UCC_STATIC_ASSERT(sizeof(ucc_base_coll_op_args_t) ==
+                      sizeof(ucc_coll_op_args_t));
     cl_team = ucc_select_cl_team(coll_args, team);
-    status =
-        UCC_CL_TEAM_IFACE(cl_team)->coll.init(&op_args, &cl_team->super, &task);
+    status  = UCC_CL_TEAM_IFACE(cl_team)->coll.init(
+        (ucc_base_coll_op_args_t *)coll_args, &cl_team->super, task);
     if (status != UCC_OK) {
         //TODO more descriptive error msg
         ucc_error("failed to init collective");
         return status;
     }
+    if (coll_args->buffer_info.flags & UCC_COLL_BUFF_FLAG_PERSISTENT) {
+        (*task)->flags |= UCC_COLL_TASK_FLAG_PERSISTENT;
+    }
+    (*task)->pq = cl_team->super.context->ucc_context->pq;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_collective_init(ucc_coll_op_args_t *coll_args,
+                                 ucc_coll_req_h *request, ucc_team_h team)
+{
+    ucc_coll_task_t *task;
+    ucc_status_t     status;
+
+    status = ucc_coll_init(coll_args, team, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    *request = &task->super;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_collective_init_and_post(ucc_coll_op_args_t *coll_args,
+                                          ucc_coll_req_h *request,
+                                          ucc_team_h team)
+{
+    ucc_coll_task_t *task;
+    ucc_status_t     status;
+
+    status = ucc_coll_init(coll_args, team, &task);
+    if (status != UCC_OK) {
+        return status;
+    }
+    /* fresh task, no repost checks: this is the algorithm start, it returns
+       after the first progress attempt and only enqueues if incomplete */
+    status = task->post(task);
+    if (status != UCC_OK) {
+        ucc_error("failed to post collective");
+        task->finalize(task);
+        return status;
+    }
     *request = &task->super;
     return UCC_OK;
 }
@@ -45,11 +87,30 @@ ucc_status_t ucc_collective_init(ucc_coll_op_args_t *coll_args,
 ucc_status_t ucc_collective_post(ucc_coll_req_h request)
 {
     ucc_coll_task_t *task = ucc_derived_of(request, ucc_coll_task_t);
+
+    /* the algorithm setup done at init is reused by every post of a
+       persistent request */
+    if (UCC_OPERATION_INITIALIZED != task->super.status) {
+        if (!(task->flags & UCC_COLL_TASK_FLAG_PERSISTENT)) {
+            ucc_error("request %p is not persistent and was already posted",
+                      task);
+            return UCC_ERR_INVALID_PARAM;
+        }
+        if (UCC_INPROGRESS == task->super.status) {
+            ucc_error("persistent request %p is still in progress", task);
+            return UCC_ERR_INVALID_PARAM;
+        }
+        /* the progress call that completed the task may still hold it */
+        ucc_progress_queue_fence(task->pq);
+    }
     return task->post(task);
 }
 
 ucc_status_t ucc_collective_finalize(ucc_coll_req_h request)
 {
     ucc_coll_task_t *task = ucc_derived_of(request, ucc_coll_task_t);
+
+    /* the progress call that completed the task may still hold it */
+    ucc_progress_queue_fence(task->pq);
     return task->finalize(task);
 }
@@ -11,6 +11,8 @@
 #include "utils/ucc_log.h"
 #include "utils/ucc_list.h"
 #include "ucc_progress_queue.h"
+#include <limits.h>
+
 ucc_status_t ucc_context_config_read(ucc_lib_info_t *lib, const char *filename,
                                      ucc_context_config_t **config_p)
 {
@@ -335,6 +337,14 @@ ucc_status_t ucc_context_create(ucc_lib_h lib,
         ucc_error("failed to init progress queue for context %p", ctx);
         goto error_ctx_create;
     }
+    status = ucc_mpool_init(&ctx->edge_mp, sizeof(ucc_event_listener_t),
+                            UCC_CACHE_LINE_SIZE, 128, UINT_MAX, NULL, NULL,
+                            "ucc_edge_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to init schedule edges mpool for context %p", ctx);
+        ucc_progress_queue_finalize(ctx->pq);
+        goto error_ctx_create;
+    }
     ucc_info("created ucc context %p for lib %s", ctx, lib->full_prefix);
     *context = ctx;
     return UCC_OK;
@@ -373,6 +383,7 @@ ucc_status_t ucc_context_destroy(ucc_context_t *context)
         }
         tl_lib->iface->context.destroy(&tl_ctx->super);
     }
+    ucc_mpool_cleanup(&context->edge_mp, 1);
     ucc_progress_queue_finalize(context->pq);
     ucc_free(context->tl_ctx);
     ucc_free(context);
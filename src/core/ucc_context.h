@@ -31,6 +31,7 @@ typedef struct ucc_context {
     int                     n_tl_ctx;
     ucc_list_link_t         progress_list;
     ucc_progress_queue_t   *pq;
+    ucc_mpool_t             edge_mp; /* schedule event listeners */
 } ucc_context_t;
 
 typedef struct ucc_context_config {
@@ -108,6 +108,42 @@ ucc_status_t ucc_mc_reduce(const void *src1, const void *src2,
     return mc_ops[mem_type]->reduce(src1, src2, dst, count, dt, op);
 }
 
+ucc_status_t ucc_mc_reduce_multi(const void *src1, const void *src2,
+                                 void *dst, size_t n_vectors, size_t count,
+                                 size_t stride, ucc_datatype_t dt,
+                                 ucc_memory_type_t mem_type,
+                                 ucc_reduction_op_t op)
+{
+    ucc_status_t status;
+    size_t       i;
+
+    UCC_CHECK_MC_AVAILABLE(mem_type);
+    if (mc_ops[mem_type]->reduce_multi) {
+        return mc_ops[mem_type]->reduce_multi(src1, src2, dst, n_vectors,
+                                              count, stride, dt, op);
+    }
+    /* component has no multi-vector kernel: reduce one vector at a time */
+    status = mc_ops[mem_type]->reduce(src1, src2, dst, count, dt, op);
+    for (i = 1; i < n_vectors && UCC_OK == status; i++) {
+        status = mc_ops[mem_type]->reduce(
+            dst, (void *)((ptrdiff_t)src2 + i * stride), dst, count, dt, op);
+    }
+    return status;
+}
+
+ucc_status_t ucc_mc_memcpy(void *dst, const void *src, size_t len,
+                           ucc_memory_type_t dst_mem_type,
+                           ucc_memory_type_t src_mem_type)
+{
+    /* host to host copies are handled by cpu component, any other
+       combination is handled by the component of non-host memory */
+    ucc_memory_type_t mt = (dst_mem_type == UCC_MEMORY_TYPE_HOST) ?
+                           src_mem_type : dst_mem_type;
+
+    UCC_CHECK_MC_AVAILABLE(mt);
+    return mc_ops[mt]->memcpy(dst, src, len, dst_mem_type, src_mem_type);
+}
+
 ucc_status_t ucc_mc_free(void *ptr, ucc_memory_type_t mem_type)
 {
     UCC_CHECK_MC_AVAILABLE(mem_type);
@@ -19,6 +19,21 @@ ucc_status_t ucc_mc_alloc(void **ptr, size_t len, ucc_memory_type_t mem_type);
 
 ucc_status_t ucc_mc_free(void *ptr, ucc_memory_type_t mem_type);
 
+ucc_status_t ucc_mc_reduce(const void *src1, const void *src2, void *dst,
+                           size_t count, ucc_datatype_t dt,
+                           ucc_memory_type_t mem_type, ucc_reduction_op_t op);
+
+/* dst = src1 op src2[0] op ... op src2[n_vectors - 1], where the vectors of
+   src2 are "stride" bytes apart. dst may be the same buffer as src1. */
+ucc_status_t ucc_mc_reduce_multi(const void *src1, const void *src2, void *dst,
+                                 size_t n_vectors, size_t count, size_t stride,
+                                 ucc_datatype_t dt, ucc_memory_type_t mem_type,
+                                 ucc_reduction_op_t op);
+
+ucc_status_t ucc_mc_memcpy(void *dst, const void *src, size_t len,
+                           ucc_memory_type_t dst_mem_type,
+                           ucc_memory_type_t src_mem_type);
+
 ucc_status_t ucc_mc_finalize();
 
 #endif
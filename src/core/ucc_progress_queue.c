@@ -7,11 +7,14 @@
 #include "ucc_progress_queue.h"
 
 ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq);
+ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq);
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
-                                     ucc_thread_mode_t      tm)      /* NOLINT */
+                                     ucc_thread_mode_t      tm)
 {
-    // TODO add branch if tm == THREAD_MULTIPLE return pq_mt_init and remove NOLINT
+    if (UCC_THREAD_MULTIPLE == tm) {
+        return ucc_pq_mt_init(pq);
+    }
     return ucc_pq_st_init(pq);
 }
 
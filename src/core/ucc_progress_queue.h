@@ -13,6 +13,7 @@ struct ucc_progress_queue {
     void (*enqueue)(ucc_progress_queue_t *pq, ucc_coll_task_t *task);
     int  (*progress)(ucc_progress_queue_t *pq);
     void (*finalize)(ucc_progress_queue_t *pq);
+    void (*fence)(ucc_progress_queue_t *pq);
 };
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
@@ -29,6 +30,16 @@ static inline int ucc_progress_queue(ucc_progress_queue_t *pq)
     return pq->progress(pq);
 }
 
+/* A task is completed from within the progress call, which still accesses
+   it after its status is set to UCC_OK. Once the owner of a task sees
+   UCC_OK, the fence waits for that progress call to return, so the task
+   can be finalized or posted again. Must not be called from within
+   progress. */
+static inline void ucc_progress_queue_fence(ucc_progress_queue_t *pq)
+{
+    pq->fence(pq);
+}
+
 void ucc_progress_queue_finalize(ucc_progress_queue_t *pq);
 
 #endif
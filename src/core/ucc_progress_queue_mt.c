@@ -0,0 +1,139 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "ucc_progress_queue.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include <sched.h>
+
+/* Progress queue for UCC_THREAD_MULTIPLE contexts. Any thread may enqueue:
+   tasks are pushed with CAS on a lock-free LIFO of list_elem links, the
+   consumer takes the whole LIFO with one exchange, so there is no ABA.
+   Only one thread progresses at a time: it owns the task list, concurrent
+   callers find the queue busy and return right away.
+   The task progress fn sets UCC_OK before the task is dequeued and its
+   completion is notified, so the owner may see it while the task is still
+   in use: the fence waits for the end of the progress pass in flight,
+   passes are counted by seq, which is odd while some thread progresses. */
+typedef struct ucc_pq_mt {
+    ucc_progress_queue_t super;
+    ucc_list_link_t     *pending; /* lock-free LIFO of enqueued tasks */
+    unsigned long        seq;     /* 2 * number of passes, +1 in a pass */
+    ucc_list_link_t      list;    /* tasks owned by the progressing thread */
+} ucc_pq_mt_t;
+
+/* Move the enqueued tasks to the list in the enqueue order */
+static inline void ucc_pq_mt_drain(ucc_pq_mt_t *pq_mt)
+{
+    ucc_list_link_t *elem, *next, *fifo = NULL;
+
+    elem = __atomic_exchange_n(&pq_mt->pending, NULL, __ATOMIC_ACQUIRE);
+    while (elem) {
+        next       = elem->next;
+        elem->next = fifo;
+        fifo       = elem;
+        elem       = next;
+    }
+    while (fifo) {
+        next = fifo->next;
+        ucc_list_add_tail(&pq_mt->list, fifo);
+        fifo = next;
+    }
+}
+
+static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_t     *pq_mt        = ucc_derived_of(pq, ucc_pq_mt_t);
+    unsigned long    seq          = __atomic_load_n(&pq_mt->seq,
+                                                    __ATOMIC_RELAXED);
+    int              n_progressed = 0;
+    ucc_coll_task_t *task, *tmp;
+    ucc_status_t     status;
+
+    if ((seq & 1) ||
+        !__atomic_compare_exchange_n(&pq_mt->seq, &seq, seq + 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    /* the odd seq is visible before any status set in this pass */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ucc_pq_mt_drain(pq_mt);
+    ucc_list_for_each_safe(task, tmp, &pq_mt->list, list_elem) {
+        if (task->progress) {
+            status = task->progress(task);
+            if (status < 0) {
+                n_progressed = status;
+                break;
+            }
+        }
+        if (UCC_OK == task->super.status) {
+            n_progressed++;
+            /* dequeue first: a listener may post the task again, that goes
+               to the pending LIFO and is picked up by the next progress */
+            ucc_list_del(&task->list_elem);
+            status = ucc_event_manager_notify(&task->em, UCC_EVENT_COMPLETED);
+            if (status != UCC_OK) {
+                n_progressed = status;
+                break;
+            }
+        }
+    }
+    __atomic_store_n(&pq_mt->seq, seq + 2, __ATOMIC_RELEASE);
+    return n_progressed;
+}
+
+static void ucc_pq_mt_fence(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_t  *pq_mt = ucc_derived_of(pq, ucc_pq_mt_t);
+    unsigned long seq;
+
+    /* pairs with the fence after seq is made odd: the pass that set the
+       status seen by the caller is either over or still has this seq */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    seq = __atomic_load_n(&pq_mt->seq, __ATOMIC_ACQUIRE);
+    if (!(seq & 1)) {
+        return;
+    }
+    while (seq == __atomic_load_n(&pq_mt->seq, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+}
+
+static void ucc_pq_mt_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
+{
+    ucc_pq_mt_t     *pq_mt = ucc_derived_of(pq, ucc_pq_mt_t);
+    ucc_list_link_t *head  = __atomic_load_n(&pq_mt->pending, __ATOMIC_RELAXED);
+
+    do {
+        task->list_elem.next = head;
+    } while (!__atomic_compare_exchange_n(&pq_mt->pending, &head,
+                                          &task->list_elem, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static void ucc_pq_mt_finalize(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_t);
+    ucc_free(pq_mt);
+}
+
+ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq)
+{
+    ucc_pq_mt_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
+    if (!pq_mt) {
+        ucc_error("failed to allocate %zd bytes for pq_mt", sizeof(*pq_mt));
+        return UCC_ERR_NO_MEMORY;
+    }
+    ucc_list_head_init(&pq_mt->list);
+    pq_mt->pending        = NULL;
+    pq_mt->seq            = 0;
+    pq_mt->super.enqueue  = ucc_pq_mt_enqueue;
+    pq_mt->super.progress = ucc_pq_mt_progress;
+    pq_mt->super.finalize = ucc_pq_mt_finalize;
+    pq_mt->super.fence    = ucc_pq_mt_fence;
+    *pq                   = &pq_mt->super;
+    return UCC_OK;
+}
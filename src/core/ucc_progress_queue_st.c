@@ -29,11 +29,12 @@ static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
         }
         if (UCC_OK == task->super.status) {
             n_progressed++;
+            /* dequeue first: a listener may post the task again */
+            ucc_list_del(&task->list_elem);
             status = ucc_event_manager_notify(&task->em, UCC_EVENT_COMPLETED);
             if (status != UCC_OK) {
                 return status;
             }
-            ucc_list_del(&task->list_elem);
         }
     }
     return n_progressed;
@@ -45,6 +46,11 @@ static void ucc_pq_st_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
     ucc_list_add_tail(&pq_st->list, &task->list_elem);
 }
 
+/* the owner and the progressing thread are the same */
+static void ucc_pq_st_fence(ucc_progress_queue_t *pq)
+{
+}
+
 static void ucc_pq_st_finalize(ucc_progress_queue_t *pq)
 {
     ucc_pq_st_t *pq_st = ucc_derived_of(pq, ucc_pq_st_t);
@@ -62,6 +68,7 @@ ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq)
     pq_st->super.enqueue  = ucc_pq_st_enqueue;
     pq_st->super.progress = ucc_pq_st_progress;
     pq_st->super.finalize = ucc_pq_st_finalize;
+    pq_st->super.fence    = ucc_pq_st_fence;
     *pq                   = &pq_st->super;
     return UCC_OK;
 }
@@ -3,41 +3,74 @@
  * See file LICENSE for terms.
  */
 #include "ucc_schedule.h"
+#include "core/ucc_context.h"
 #include "utils/ucc_compiler_def.h"
+#include "utils/ucc_log.h"
 
 ucc_status_t ucc_event_manager_init(ucc_event_manager_t *em)
 {
     int i;
     for (i = 0; i < UCC_EVENT_LAST; i++) {
-        em->listeners_size[i] = 0;
+        ucc_list_head_init(&em->listeners[i]);
     }
     return UCC_OK;
 }
 
-void ucc_event_manager_subscribe(ucc_event_manager_t *em, ucc_event_t event,
-                                 ucc_coll_task_t *task)
+static void ucc_event_listeners_release(ucc_list_link_t *listeners)
 {
-    ucc_assert(em->listeners_size[event] < MAX_LISTENERS);
-    em->listeners[event][em->listeners_size[event]] = task;
-    em->listeners_size[event]++;
+    ucc_event_listener_t *listener, *tmp;
+
+    ucc_list_for_each_safe(listener, tmp, listeners, list_elem) {
+        ucc_list_del(&listener->list_elem);
+        ucc_mpool_put(listener);
+    }
+}
+
+void ucc_event_manager_cleanup(ucc_event_manager_t *em)
+{
+    int i;
+
+    for (i = 0; i < UCC_EVENT_LAST; i++) {
+        ucc_event_listeners_release(&em->listeners[i]);
+    }
+}
+
+ucc_status_t ucc_event_manager_subscribe(ucc_event_manager_t *em,
+                                         ucc_event_t event,
+                                         ucc_coll_task_t *task,
+                                         ucc_task_event_handler_p handler,
+                                         ucc_mpool_t *mp)
+{
+    ucc_event_listener_t *listener = ucc_mpool_get(mp);
+
+    if (!listener) {
+        ucc_error("failed to get event listener from mpool");
+        return UCC_ERR_NO_MEMORY;
+    }
+    listener->task    = task;
+    listener->handler = handler;
+    ucc_list_add_tail(&em->listeners[event], &listener->list_elem);
+    return UCC_OK;
 }
 
 ucc_status_t ucc_coll_task_init(ucc_coll_task_t *task)
 {
     task->super.status = UCC_OPERATION_INITIALIZED;
+    task->flags        = 0;
+    task->n_deps       = 0;
+    task->n_deps_left  = 0;
+    task->pq           = NULL;
     return ucc_event_manager_init(&task->em);
 }
 
 ucc_status_t ucc_event_manager_notify(ucc_event_manager_t *em,
                                       ucc_event_t event)
 {
-    ucc_coll_task_t *task;
-    ucc_status_t     status;
-    int              i;
+    ucc_event_listener_t *listener;
+    ucc_status_t          status;
 
-    for (i = 0; i < em->listeners_size[event]; i++) {
-        task   = em->listeners[event][i];
-        status = task->handlers[event](task);
+    ucc_list_for_each(listener, &em->listeners[event], list_elem) {
+        status = listener->handler(listener->task);
         if (status != UCC_OK) {
             return status;
         }
@@ -45,39 +78,154 @@ ucc_status_t ucc_event_manager_notify(ucc_event_manager_t *em,
     return UCC_OK;
 }
 
+/* Posts a task whose dependencies are satisfied. A task that completes
+   within its post fn is not enqueued to the progress queue, so its
+   completion is signalled right away. */
+static ucc_status_t ucc_schedule_post_task(ucc_coll_task_t *task)
+{
+    ucc_status_t status;
+
+    task->n_deps_left = task->n_deps;
+    status            = task->post(task);
+    if (status < 0) {
+        return status;
+    }
+    if (UCC_OK == task->super.status) {
+        return ucc_event_manager_notify(&task->em, UCC_EVENT_COMPLETED);
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_schedule_started_handler(ucc_coll_task_t *task)
+{
+    if (0 == task->n_deps) {
+        return ucc_schedule_post_task(task);
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_schedule_dep_handler(ucc_coll_task_t *task)
+{
+    ucc_assert(task->n_deps_left > 0);
+    if (0 == --task->n_deps_left) {
+        return ucc_schedule_post_task(task);
+    }
+    return UCC_OK;
+}
+
 static ucc_status_t ucc_schedule_completed_handler(ucc_coll_task_t *task)
 {
     ucc_schedule_t *self = ucc_container_of(task, ucc_schedule_t, super);
     self->n_completed_tasks += 1;
     if (self->n_completed_tasks == self->n_tasks) {
         self->super.super.status = UCC_OK;
+        if (!self->starting) {
+            return ucc_event_manager_notify(&self->super.em,
+                                            UCC_EVENT_COMPLETED);
+        }
     }
     return UCC_OK;
 }
 
+static ucc_status_t ucc_schedule_post(ucc_coll_task_t *task)
+{
+    return ucc_schedule_start(ucc_derived_of(task, ucc_schedule_t));
+}
+
 ucc_status_t ucc_schedule_init(ucc_schedule_t *schedule, ucc_context_t *ctx)
 {
     ucc_status_t status;
     status = ucc_coll_task_init(&schedule->super);
-    schedule->super.handlers[UCC_EVENT_COMPLETED] =
-        ucc_schedule_completed_handler;
+    schedule->super.post        = ucc_schedule_post;
+    schedule->super.progress    = NULL;
+    schedule->super.finalize    = ucc_schedule_finalize;
+    schedule->super.schedule    = NULL;
     schedule->n_completed_tasks = 0;
     schedule->ctx               = ctx;
     schedule->n_tasks           = 0;
+    schedule->starting          = 0;
     return status;
 }
 
-void ucc_schedule_add_task(ucc_schedule_t *schedule, ucc_coll_task_t *task)
+ucc_status_t ucc_schedule_add_task(ucc_schedule_t *schedule,
+                                   ucc_coll_task_t *task)
 {
-    ucc_event_manager_subscribe(&task->em, UCC_EVENT_COMPLETED,
-                                &schedule->super);
+    ucc_status_t status;
+
+    status = ucc_event_manager_subscribe(&task->em, UCC_EVENT_COMPLETED,
+                                         &schedule->super,
+                                         ucc_schedule_completed_handler,
+                                         &schedule->ctx->edge_mp);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_event_manager_subscribe(&schedule->super.em,
+                                         UCC_EVENT_SCHEDULE_STARTED, task,
+                                         ucc_schedule_started_handler,
+                                         &schedule->ctx->edge_mp);
+    if (UCC_OK != status) {
+        return status;
+    }
     task->schedule = schedule;
     schedule->n_tasks++;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_schedule_add_dep(ucc_schedule_t *schedule,
+                                  ucc_coll_task_t *task,
+                                  ucc_coll_task_t *dep)
+{
+    ucc_status_t status;
+
+    ucc_assert(task->schedule == schedule && dep->schedule == schedule);
+    status = ucc_event_manager_subscribe(&dep->em, UCC_EVENT_COMPLETED, task,
+                                         ucc_schedule_dep_handler,
+                                         &schedule->ctx->edge_mp);
+    if (UCC_OK != status) {
+        return status;
+    }
+    task->n_deps++;
+    task->n_deps_left++;
+    return UCC_OK;
 }
 
 ucc_status_t ucc_schedule_start(ucc_schedule_t *schedule)
 {
-    schedule->super.super.status = UCC_INPROGRESS;
-    return ucc_event_manager_notify(&schedule->super.em,
-                                    UCC_EVENT_SCHEDULE_STARTED);
+    ucc_status_t status;
+
+    schedule->n_completed_tasks  = 0;
+    schedule->super.super.status =
+        (0 == schedule->n_tasks) ? UCC_OK : UCC_INPROGRESS;
+    schedule->starting           = 1;
+    status = ucc_event_manager_notify(&schedule->super.em,
+                                      UCC_EVENT_SCHEDULE_STARTED);
+    schedule->starting           = 0;
+    return status;
+}
+
+ucc_status_t ucc_schedule_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t       *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_list_link_t      *tasks    =
+        &schedule->super.em.listeners[UCC_EVENT_SCHEDULE_STARTED];
+    ucc_status_t          status   = UCC_OK;
+    ucc_event_listener_t *listener;
+    ucc_coll_task_t      *t;
+    ucc_status_t          st;
+
+    ucc_list_for_each(listener, tasks, list_elem) {
+        t = listener->task;
+        /* edges out of t, the tasks of a nested schedule are released by
+           its own finalize */
+        ucc_event_listeners_release(&t->em.listeners[UCC_EVENT_COMPLETED]);
+        if (t->finalize) {
+            st = t->finalize(t);
+            if (UCC_OK != st) {
+                status = st;
+            }
+        }
+    }
+    ucc_event_manager_cleanup(&schedule->super.em);
+    schedule->n_tasks = 0;
+    return status;
 }
@@ -7,7 +7,7 @@
 
 #include "ucc/api/ucc.h"
 #include "utils/ucc_list.h"
-#define MAX_LISTENERS 4
+#include "utils/ucc_mpool.h"
 
 typedef enum {
     UCC_EVENT_COMPLETED = 0,
@@ -15,27 +15,46 @@ typedef enum {
     UCC_EVENT_LAST
 } ucc_event_t;
 
+typedef enum {
+    /* the task may be posted again once completed */
+    UCC_COLL_TASK_FLAG_PERSISTENT = UCC_BIT(0),
+} ucc_coll_task_flags_t;
+
 typedef struct ucc_coll_task ucc_coll_task_t;
 
 typedef ucc_status_t (*ucc_task_event_handler_p)(ucc_coll_task_t *task);
 typedef ucc_status_t (*ucc_coll_post_fn_t)(ucc_coll_task_t *task);
 typedef ucc_status_t (*ucc_coll_finalize_fn_t)(ucc_coll_task_t *task);
 
+/* Subscription of a task to an event of another task, ie an edge of the
+   schedule DAG. Listeners are allocated from the context edge_mp. */
+typedef struct ucc_event_listener {
+    ucc_list_link_t          list_elem;
+    ucc_coll_task_t         *task;
+    ucc_task_event_handler_p handler;
+} ucc_event_listener_t;
+
 typedef struct ucc_event_manager {
-    ucc_coll_task_t *listeners[UCC_EVENT_LAST][MAX_LISTENERS];
-    int              listeners_size[UCC_EVENT_LAST];
+    ucc_list_link_t listeners[UCC_EVENT_LAST];
 } ucc_event_manager_t;
 
 typedef struct ucc_coll_task {
     ucc_coll_req_t             super;
+    uint32_t                   flags;
     ucc_coll_post_fn_t         post;
     ucc_coll_finalize_fn_t     finalize;
     ucc_event_manager_t        em;
-    ucc_task_event_handler_p   handlers[UCC_EVENT_LAST];
     ucc_status_t             (*progress)(struct ucc_coll_task *self);
     struct ucc_schedule       *schedule;
+    /* in-degree in the schedule DAG: the task is posted once n_deps_left
+       predecessors have completed, n_deps_left is rearmed on post */
+    int                        n_deps;
+    int                        n_deps_left;
     /* used for progress queue */
     ucc_list_link_t            list_elem;
+    /* progress queue of the context, set for the tasks handed out to the
+       user as requests: completion seen by the user is fenced against it */
+    struct ucc_progress_queue *pq;
 } ucc_coll_task_t;
 
 typedef struct ucc_context ucc_context_t;
@@ -43,16 +62,37 @@ typedef struct ucc_schedule {
     ucc_coll_task_t super;
     int             n_completed_tasks;
     int             n_tasks;
+    /* set while ucc_schedule_start posts the tasks. If the schedule
+       completes within start, completion is signalled by the poster, as
+       for any task that completes within its post fn */
+    int             starting;
     ucc_context_t  *ctx;
 } ucc_schedule_t;
 
 ucc_status_t ucc_event_manager_init(ucc_event_manager_t *em);
+void         ucc_event_manager_cleanup(ucc_event_manager_t *em);
 ucc_status_t ucc_coll_task_init(ucc_coll_task_t *task);
-void ucc_event_manager_subscribe(ucc_event_manager_t *em, ucc_event_t event,
-                                 ucc_coll_task_t *task);
+ucc_status_t ucc_event_manager_subscribe(ucc_event_manager_t *em,
+                                         ucc_event_t event,
+                                         ucc_coll_task_t *task,
+                                         ucc_task_event_handler_p handler,
+                                         ucc_mpool_t *mp);
 ucc_status_t ucc_event_manager_notify(ucc_event_manager_t *em,
                                       ucc_event_t event);
 ucc_status_t ucc_schedule_init(ucc_schedule_t *schedule, ucc_context_t *ctx);
-void ucc_schedule_add_task(ucc_schedule_t *schedule, ucc_coll_task_t *task);
+
+/* Adds the task to the schedule. Tasks without dependencies are posted by
+   ucc_schedule_start, the schedule completes when all its tasks complete. */
+ucc_status_t ucc_schedule_add_task(ucc_schedule_t *schedule,
+                                   ucc_coll_task_t *task);
+
+/* Makes the task depend on dep: the task is posted only after all its
+   dependencies have completed. Both tasks must belong to the schedule. */
+ucc_status_t ucc_schedule_add_dep(ucc_schedule_t *schedule,
+                                  ucc_coll_task_t *task,
+                                  ucc_coll_task_t *dep);
 ucc_status_t ucc_schedule_start(ucc_schedule_t *schedule);
+
+/* Releases the DAG edges and finalizes all the tasks of the schedule */
+ucc_status_t ucc_schedule_finalize(ucc_coll_task_t *task);
 #endif
@@ -0,0 +1,202 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+#include "ucc_schedule_pipelined.h"
+#include "core/ucc_context.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+static ucc_status_t
+ucc_schedule_pipelined_frag_completed(ucc_coll_task_t *task);
+
+/* Task running fragment frag_num: fragment f of full size runs on task
+   f % n_frags, the smaller last fragment has a dedicated task */
+static inline ucc_schedule_frag_t *
+ucc_schedule_pipelined_frag(ucc_schedule_pipelined_t *schedule, int frag_num)
+{
+    if (frag_num == schedule->n_frags_total - 1 &&
+        schedule->last_frag_count != schedule->frag_count) {
+        return &schedule->frags[schedule->n_frag_tasks - 1];
+    }
+    return &schedule->frags[frag_num % schedule->n_frags];
+}
+
+static ucc_status_t
+ucc_schedule_pipelined_post_frag(ucc_schedule_pipelined_t *schedule,
+                                 int frag_num)
+{
+    ucc_schedule_frag_t *frag = ucc_schedule_pipelined_frag(schedule,
+                                                            frag_num);
+    ucc_status_t         status;
+
+    frag->frag_num = frag_num;
+    status         = schedule->frag_setup(schedule, frag->task, frag_num);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = frag->task->post(frag->task);
+    if (status < 0) {
+        return status;
+    }
+    if (UCC_OK == frag->task->super.status) {
+        /* completed within post, the task is not in the progress queue */
+        return ucc_schedule_pipelined_frag_completed(frag->task);
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_schedule_pipelined_frag_completed(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task->schedule, ucc_schedule_pipelined_t);
+    ucc_schedule_frag_t      *frag     = schedule->frags;
+    int                       next;
+
+    while (frag->task != task) {
+        frag++;
+    }
+    next = frag->frag_num + schedule->n_frags;
+    schedule->n_frags_completed++;
+    if (schedule->n_frags_completed == schedule->n_frags_total) {
+        schedule->super.super.super.status = UCC_OK;
+        if (!schedule->super.starting) {
+            return ucc_event_manager_notify(&schedule->super.super.em,
+                                            UCC_EVENT_COMPLETED);
+        }
+        return UCC_OK;
+    }
+    if (next < schedule->n_frags_total) {
+        return ucc_schedule_pipelined_post_frag(schedule, next);
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t              status   = UCC_OK;
+    int                       i;
+
+    schedule->n_frags_completed        = 0;
+    schedule->super.super.super.status = UCC_INPROGRESS;
+    schedule->super.starting           = 1;
+    for (i = 0; i < ucc_min(schedule->n_frags, schedule->n_frags_total); i++) {
+        status = ucc_schedule_pipelined_post_frag(schedule, i);
+        if (UCC_OK != status) {
+            break;
+        }
+    }
+    schedule->super.starting           = 0;
+    return status;
+}
+
+ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t              status   = UCC_OK;
+    ucc_coll_task_t          *frag;
+    ucc_status_t              st;
+    int                       i;
+
+    for (i = 0; i < schedule->n_frag_tasks; i++) {
+        frag = schedule->frags[i].task;
+        ucc_event_manager_cleanup(&frag->em);
+        st = frag->finalize(frag);
+        if (UCC_OK != st) {
+            status = st;
+        }
+    }
+    ucc_event_manager_cleanup(&schedule->super.super.em);
+    ucc_free(schedule->frags);
+    return status;
+}
+
+ucc_status_t
+ucc_schedule_pipelined_init(ucc_base_coll_op_args_t     *coll_args,
+                            ucc_base_team_t             *team,
+                            ucc_schedule_frag_init_fn_t  frag_init,
+                            ucc_schedule_frag_setup_fn_t frag_setup,
+                            size_t frag_size, int n_frags, ucc_context_t *ctx,
+                            ucc_schedule_pipelined_t    *schedule)
+{
+    size_t                  count   = UCC_COLL_ARGS_COUNT(coll_args->args);
+    size_t                  dt_size =
+        ucc_dt_size(coll_args->args.buffer_info.src_datatype);
+    ucc_base_coll_op_args_t frag_args;
+    ucc_coll_task_t        *frag;
+    ucc_status_t            status;
+    size_t                  frag_count;
+    int                     i, n_full;
+
+    if (0 == dt_size) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_schedule_init(&schedule->super, ctx);
+    if (UCC_OK != status) {
+        return status;
+    }
+    memcpy(&schedule->args, &coll_args->args, sizeof(ucc_coll_op_args_t));
+    frag_count                = ucc_max(frag_size / dt_size, 1);
+    schedule->n_frags_total   = ucc_max((count + frag_count - 1) / frag_count,
+                                        1);
+    schedule->frag_count      = (1 == schedule->n_frags_total) ? count
+                                                               : frag_count;
+    schedule->last_frag_count =
+        count - (schedule->n_frags_total - 1) * schedule->frag_count;
+    schedule->n_frags         = ucc_max(n_frags, 1);
+    schedule->frag_setup      = frag_setup;
+    if (schedule->last_frag_count != schedule->frag_count) {
+        n_full                 = ucc_min(schedule->n_frags,
+                                         schedule->n_frags_total - 1);
+        schedule->n_frag_tasks = n_full + 1;
+    } else {
+        n_full                 = ucc_min(schedule->n_frags,
+                                         schedule->n_frags_total);
+        schedule->n_frag_tasks = n_full;
+    }
+    schedule->frags = ucc_malloc(schedule->n_frag_tasks *
+                                     sizeof(ucc_schedule_frag_t),
+                                 "pipelined_frags");
+    if (!schedule->frags) {
+        ucc_error("failed to allocate %zd bytes for pipelined frags",
+                  schedule->n_frag_tasks * sizeof(ucc_schedule_frag_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    memcpy(&frag_args, coll_args, sizeof(frag_args));
+    for (i = 0; i < schedule->n_frag_tasks; i++) {
+        /* fragment tasks keep pointing to the counts of the schedule */
+        frag_args.args.buffer_info.src_counts =
+            (i < n_full) ? &schedule->frag_count : &schedule->last_frag_count;
+        status = frag_init(&frag_args, team, &frag);
+        if (UCC_OK != status) {
+            goto err;
+        }
+        schedule->frags[i].task = frag;
+        frag->schedule          = &schedule->super;
+        status = ucc_event_manager_subscribe(
+            &frag->em, UCC_EVENT_COMPLETED, frag,
+            ucc_schedule_pipelined_frag_completed, &ctx->edge_mp);
+        if (UCC_OK != status) {
+            i++;
+            goto err;
+        }
+    }
+    schedule->super.super.post     = ucc_schedule_pipelined_post;
+    schedule->super.super.finalize = ucc_schedule_pipelined_finalize;
+    return UCC_OK;
+
+err:
+    while (i-- > 0) {
+        frag = schedule->frags[i].task;
+        ucc_event_manager_cleanup(&frag->em);
+        frag->finalize(frag);
+    }
+    ucc_free(schedule->frags);
+    return status;
+}
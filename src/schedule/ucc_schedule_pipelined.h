@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+#ifndef UCC_SCHEDULE_PIPELINED_H_
+#define UCC_SCHEDULE_PIPELINED_H_
+
+#include "ucc_schedule.h"
+#include "components/base/ucc_base_iface.h"
+
+/**
+ *  Pipelined schedule: the buffer of a count based collective (bcast,
+ *  reduce, allreduce) is split into n_frags_total fragments of frag_count
+ *  elements (the last one may be smaller). Each fragment is an instance of
+ *  the collective created by frag_init, at most n_frags of them are in
+ *  flight. Fragment tasks are created once and recycled: when the task of
+ *  fragment f completes it is set up for fragment f + n_frags and posted
+ *  again. Fragment f always runs on the same task on every rank, so the
+ *  p2p matching of the fragments does not depend on completion order.
+ */
+typedef struct ucc_schedule_pipelined ucc_schedule_pipelined_t;
+
+/* Creates the fragment task for the given args, the same as coll.init of
+   the base iface */
+typedef ucc_status_t (*ucc_schedule_frag_init_fn_t)(
+    ucc_base_coll_op_args_t *coll_args, ucc_base_team_t *team,
+    ucc_coll_task_t **frag);
+
+/* Points the fragment task to the data of fragment frag_num, see
+   ucc_schedule_pipelined_frag_offset */
+typedef ucc_status_t (*ucc_schedule_frag_setup_fn_t)(
+    ucc_schedule_pipelined_t *schedule, ucc_coll_task_t *frag, int frag_num);
+
+typedef struct ucc_schedule_frag {
+    ucc_coll_task_t *task;
+    int              frag_num; /* fragment the task is running */
+} ucc_schedule_frag_t;
+
+typedef struct ucc_schedule_pipelined {
+    ucc_schedule_t               super;
+    ucc_coll_op_args_t           args;
+    ucc_schedule_frag_setup_fn_t frag_setup;
+    /* n_frags tasks of frag_count elements, plus the task of the last
+       fragment if it is smaller */
+    ucc_schedule_frag_t         *frags;
+    int                          n_frag_tasks;
+    int                          n_frags;
+    int                          n_frags_total;
+    int                          n_frags_completed;
+    /* counts of the fragment tasks args */
+    ucc_count_t                  frag_count;
+    ucc_count_t                  last_frag_count;
+} ucc_schedule_pipelined_t;
+
+/**
+ *  @param [in]  coll_args     Args of the whole collective
+ *  @param [in]  team          Team passed to frag_init
+ *  @param [in]  frag_init     Init of the fragment collective
+ *  @param [in]  frag_setup    Setup of the fragment task for the next fragment
+ *  @param [in]  frag_size     Fragment size in bytes
+ *  @param [in]  n_frags       Maximum number of fragments in flight
+ *  @param [in]  ctx           Core context
+ *  @param [out] schedule      Initialized schedule
+ */
+ucc_status_t
+ucc_schedule_pipelined_init(ucc_base_coll_op_args_t     *coll_args,
+                            ucc_base_team_t             *team,
+                            ucc_schedule_frag_init_fn_t  frag_init,
+                            ucc_schedule_frag_setup_fn_t frag_setup,
+                            size_t frag_size, int n_frags, ucc_context_t *ctx,
+                            ucc_schedule_pipelined_t    *schedule);
+
+ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task);
+
+/* Finalizes the fragment tasks, the schedule itself is released by the
+   caller */
+ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task);
+
+/* Offset in elements of the fragment frag_num */
+static inline size_t
+ucc_schedule_pipelined_frag_offset(ucc_schedule_pipelined_t *schedule,
+                                   int frag_num)
+{
+    return (size_t)frag_num * schedule->frag_count;
+}
+#endif
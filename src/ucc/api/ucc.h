@@ -145,7 +145,9 @@ typedef enum {
  *
  *  @ref ucc_coll_type_t represents the collective operations supported by the
  *  UCC library. Currently, it supports barrier, broadcast, all-reduce, reduce,
- *  alltoall, all-gather, gather, scatter, fan-in and fan-out operations.
+ *  alltoall, all-gather, gather, scatter, fan-in, fan-out, alltoallv,
+ *  reduce-scatter, inclusive and exclusive scan, all-gatherv and gatherv
+ *  operations.
  *
  *  @endparblock
  *
@@ -160,7 +162,13 @@ typedef enum {
     UCC_COLL_TYPE_GATHER             = UCC_BIT(6),
     UCC_COLL_TYPE_SCATTER            = UCC_BIT(7),
     UCC_COLL_TYPE_FANIN              = UCC_BIT(8),
-    UCC_COLL_TYPE_FANOUT             = UCC_BIT(9)
+    UCC_COLL_TYPE_FANOUT             = UCC_BIT(9),
+    UCC_COLL_TYPE_ALLTOALLV          = UCC_BIT(10),
+    UCC_COLL_TYPE_REDUCE_SCATTER     = UCC_BIT(11),
+    UCC_COLL_TYPE_SCAN               = UCC_BIT(12),
+    UCC_COLL_TYPE_EXSCAN             = UCC_BIT(13),
+    UCC_COLL_TYPE_ALLGATHERV         = UCC_BIT(14),
+    UCC_COLL_TYPE_GATHERV            = UCC_BIT(15)
 } ucc_coll_type_t;
 
 /**
@@ -176,7 +184,11 @@ typedef enum {
  *  @ref ucc_datatype_t represents the datatypes supported by the UCC library’s
  *  collective and reduction operations. The standard operations are signed and
  *  unsigned integers of various sizes, float 16, 32, and 64, and user-defined
- *  datatypes. The UCC_DT_USERDEFINED represents the user-defined datatype. The
+ *  datatypes. The value/index pair datatypes are used with UCC_OP_MAXLOC and
+ *  UCC_OP_MINLOC, their layout is the one of the C structure with the value
+ *  field followed by the int32_t index field, e.g. UCC_DT_FLOAT64_INT32 is
+ *  struct {double value; int32_t index;}, including the padding.
+ *  The UCC_DT_USERDEFINED represents the user-defined datatype. The
  *  UCC_DT_OPAQUE is used to represent the user-defined datatypes for
  *  user-defined reductions. When UCC_DT_OPAQUE is used, the library passes the
  *  data to the user-defined reductions without any modifications.
@@ -198,6 +210,10 @@ typedef enum {
     UCC_DT_FLOAT16,
     UCC_DT_FLOAT32,
     UCC_DT_FLOAT64,
+    UCC_DT_FLOAT32_INT32,
+    UCC_DT_FLOAT64_INT32,
+    UCC_DT_INT32_INT32,
+    UCC_DT_INT64_INT32,
     UCC_DT_USERDEFINED,
     UCC_DT_OPAQUE
 } ucc_datatype_t;
@@ -1447,6 +1463,12 @@ typedef struct ucc_coll_op_args {
  *  to the user. If modified, the results of collective operations posted on the
  *  request handle are undefined.
  *
+ *  If UCC_COLL_BUFF_FLAG_PERSISTENT is set in the buffer info flags, the
+ *  request is persistent: it can be posted multiple times with
+ *  @ref ucc_collective_post, each post starts after the previous one has
+ *  completed. The algorithm selection and setup (peers, tags, scratch
+ *  buffers) is done once at init. Otherwise the request can be posted once.
+ *
  *  @endparblock
  *
  *  @return Error code as defined by ucc_status_t
@@ -1467,7 +1489,8 @@ ucc_status_t ucc_collective_init(ucc_coll_op_args_t *coll_args,
  *
  *  @ref ucc_collective_post routine posts the collective operation. It
  *  does not require synchronization between the participants for the post
- *  operation.
+ *  operation. A persistent request can be posted again once the previous
+ *  post has completed, UCC_ERR_INVALID_PARAM is returned otherwise.
  *
  *  @endparblock
  *
@@ -1493,9 +1516,11 @@ ucc_status_t ucc_collective_post(ucc_coll_req_h request);
  *  @ref ucc_collective_init_and_post initializes the collective operation
  *  and also posts the operation.
  *
- *  @note: The @ref ucc_collective_init_and_post can be implemented as a
+ *  @note: The @ref ucc_collective_init_and_post is semantically a
  *  combination of @ref ucc_collective_init and @ref ucc_collective_post
- *  routines.
+ *  routines, but it avoids the separate post call: the operation is
+ *  started right away and returns after the first progress attempt. The
+ *  returned request must be completed and finalized as usual.
  *
  *  @endparblock
  *
@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_COLL_UTILS_H_
+#define UCC_COLL_UTILS_H_
+
+#include "config.h"
+#include "ucc/api/ucc.h"
+
+#define UCC_IS_INPLACE(_args)                                                  \
+    ((_args).buffer_info.flags & UCC_COLL_BUFF_FLAG_IN_PLACE)
+
+/* Element count of the non-vector collective: src_counts points to
+   a single value which is the number of elements contributed by
+   every rank */
+#define UCC_COLL_ARGS_COUNT(_args) ((size_t)((_args).buffer_info.src_counts[0]))
+
+/* Element of the counts/displacements array of the vector collective:
+   arrays are of 64 bit values if the corresponding flag is set, of 32 bit
+   values otherwise */
+#define UCC_COLL_IS_COUNT64(_args)                                             \
+    ((_args).buffer_info.flags & UCC_COLL_BUFF_FLAG_COUNT_64BIT)
+
+#define UCC_COLL_IS_DISPL64(_args)                                             \
+    ((_args).buffer_info.flags & UCC_COLL_BUFF_FLAG_DISPLACEMENTS_64BIT)
+
+static inline size_t ucc_coll_args_get_count(const ucc_coll_op_args_t *args,
+                                             const ucc_count_t *counts, int i)
+{
+    return UCC_COLL_IS_COUNT64(*args) ? ((const uint64_t *)counts)[i]
+                                      : ((const uint32_t *)counts)[i];
+}
+
+static inline size_t
+ucc_coll_args_get_displacement(const ucc_coll_op_args_t *args,
+                               const ucc_aint_t *displ, int i)
+{
+    return UCC_COLL_IS_DISPL64(*args) ? ((const uint64_t *)displ)[i]
+                                      : ((const uint32_t *)displ)[i];
+}
+
+/**
+ *  Block decomposition of a vector of len elements into n blocks:
+ *  the first len % n blocks get one extra element.
+ */
+static inline size_t ucc_buffer_block_count(size_t len, int n, int i)
+{
+    return len / n + (((size_t)i < len % n) ? 1 : 0);
+}
+
+static inline size_t ucc_buffer_block_offset(size_t len, int n, int i)
+{
+    size_t rem = len % n;
+    return (len / n) * i + (((size_t)i < rem) ? i : rem);
+}
+
+static inline size_t ucc_dt_size(ucc_datatype_t dt)
+{
+    switch (dt) {
+    case UCC_DT_INT8:
+    case UCC_DT_UINT8:
+        return 1;
+    case UCC_DT_INT16:
+    case UCC_DT_UINT16:
+    case UCC_DT_FLOAT16:
+        return 2;
+    case UCC_DT_INT32:
+    case UCC_DT_UINT32:
+    case UCC_DT_FLOAT32:
+        return 4;
+    case UCC_DT_INT64:
+    case UCC_DT_UINT64:
+    case UCC_DT_FLOAT64:
+    case UCC_DT_FLOAT32_INT32:
+    case UCC_DT_INT32_INT32:
+        return 8;
+    case UCC_DT_INT128:
+    case UCC_DT_UINT128:
+    case UCC_DT_FLOAT64_INT32:
+    case UCC_DT_INT64_INT32:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+#endif
@@ -23,6 +23,7 @@
 #define ucc_derived_of    ucs_derived_of
 #define ucc_strncpy_safe  ucs_strncpy_safe
 #define ucc_snprintf_safe snprintf
+#define UCC_STATIC_ASSERT UCS_STATIC_ASSERT
 
 typedef ucs_log_component_config_t ucc_log_component_config_t;
 
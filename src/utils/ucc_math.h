@@ -11,5 +11,6 @@
 
 #define ucc_min(_a, _b) ucs_min((_a), (_b))
 #define ucc_max(_a, _b) ucs_max((_a), (_b))
+#define ucc_is_pow2(_n) ucs_is_pow2(_n)
 
 #endif
@@ -9,6 +9,8 @@
 #include "config.h"
 #include <ucs/datastruct/mpool.h>
 #include "ucc_compiler_def.h"
+#include "ucc_malloc.h"
+#include "ucc_log.h"
 
 typedef ucs_mpool_t ucc_mpool_t;
 #define ucc_mpool_get(_mp) ucs_mpool_get((_mp))
@@ -24,7 +26,8 @@ ucc_mpool_init(ucc_mpool_t *mp, size_t elem_size, size_t alignment,
                ucc_mpool_obj_init_fn_t    init_fn,
                ucc_mpool_obj_cleanup_fn_t cleanup_fn, const char *name)
 {
-    ucs_mpool_ops_t *ops = ucc_malloc(sizeof(*ops), "mpool_ops");
+    ucs_mpool_ops_t *ops =
+        (ucs_mpool_ops_t *)ucc_malloc(sizeof(*ops), "mpool_ops");
     if (!ops) {
         ucc_error("failed to allocate %zd bytes for mpool ops", sizeof(*ops));
         return UCC_ERR_NO_MEMORY;
@@ -224,11 +224,28 @@ UccTeam::~UccTeam()
     destroy_team();
 }
 
-UccJob::UccJob(int _n_procs) : n_procs(_n_procs)
+UccJob::UccJob(int _n_procs, const ucc_job_env_t &vars) : n_procs(_n_procs)
 {
+    ucc_job_env_t saved;
+    const char   *val;
+
+    /* config is read from the environment when the contexts are created */
+    for (auto &v : vars) {
+        val = getenv(v.first.c_str());
+        if (val) {
+            saved.push_back(std::make_pair(v.first, std::string(val)));
+        }
+        setenv(v.first.c_str(), v.second.c_str(), 1);
+    }
     for (int i = 0; i < n_procs; i++) {
         procs.push_back(std::make_shared<UccProcess>());
     }
+    for (auto &v : vars) {
+        unsetenv(v.first.c_str());
+    }
+    for (auto &v : saved) {
+        setenv(v.first.c_str(), v.second.c_str(), 1);
+    }
 }
 
 UccJob::~UccJob()
@@ -288,6 +305,18 @@ UccReq::UccReq(UccTeam_h _team, ucc_coll_op_args_t *args) :
     }
 }
 
+UccReq::UccReq(UccTeam_h _team, std::vector<ucc_coll_op_args_t> &args) :
+    team(_team)
+{
+    ucc_coll_req_h req;
+    EXPECT_EQ(team->procs.size(), args.size());
+    for (int i = 0; i < team->procs.size(); i++) {
+        EXPECT_EQ(UCC_OK, ucc_collective_init(&args[i], &req,
+                                              team->procs[i].team));
+        reqs.push_back(req);
+    }
+}
+
 UccReq::~UccReq()
 {
     for (auto r : reqs) {
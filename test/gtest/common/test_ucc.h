@@ -9,6 +9,7 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <string>
 
 /* A single processes in a Job that runs UCC.
    It has context and lib object */
@@ -73,6 +74,10 @@ public:
 };
 typedef std::shared_ptr<UccTeam> UccTeam_h;
 
+/* Environment variables set while the processes of a UccJob are created,
+   eg {"UCC_TL_UCP_ALLREDUCE_RING_THRESH", "0"} */
+typedef std::vector<std::pair<std::string, std::string>> ucc_job_env_t;
+
 /* UccJob - environent that has n_procs processes.
    Multiple UccTeams can be created from UccJob */
 class UccJob {
@@ -85,7 +90,7 @@ public:
     static UccJob* getStaticJob();
     static const std::vector<UccTeam_h> &getStaticTeams();
     int n_procs;
-    UccJob(int _n_procs = 2);
+    UccJob(int _n_procs = 2, const ucc_job_env_t &vars = ucc_job_env_t());
     ~UccJob();
     std::vector<UccProcess_h> procs;
     UccTeam_h create_team(int n_procs);
@@ -105,6 +110,8 @@ public:
 
     std::vector<ucc_coll_req_h> reqs;
     UccReq(UccTeam_h _team, ucc_coll_op_args_t *args);
+    /* Per-process collective arguments, args.size() == team->n_procs */
+    UccReq(UccTeam_h _team, std::vector<ucc_coll_op_args_t> &args);
     ~UccReq();
     void start(void);
     void wait();
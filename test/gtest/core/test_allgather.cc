@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, number of elements per rank */
+class test_allgather : public ucc::test,
+                       public ::testing::WithParamInterface<
+                           std::tuple<int, ucc_count_t>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, bool inplace) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            rbufs[r].resize(count * n_procs);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i] = r * count + i;
+            }
+            for (int i = 0; i < count * n_procs; i++) {
+                rbufs[r][i] = (inplace && i / count == r) ? i : -1;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLGATHER;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].buffer_info.flags = inplace ? UCC_COLL_BUFF_FLAG_IN_PLACE : 0;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int i = 0; i < count * n_procs; i++) {
+                EXPECT_EQ(i, rbufs[r][i]);
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_allgather, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allgather, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allgather,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16), /* team size */
+                       ::testing::Values(1, 3, 1024, 65536))); /* count     */
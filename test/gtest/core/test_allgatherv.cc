@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, max number of elements per rank, blocks placed in
+   reverse rank order. Rank r contributes (r * 7 + 3) % (max + 1) elements,
+   so some of the blocks are empty. With gaps, rank r leaves (p + r) % 3
+   unused elements after block p, so every rank has its own displacements. */
+class test_allgatherv : public ucc::test,
+                        public ::testing::WithParamInterface<
+                            std::tuple<int, int, bool>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    std::vector<uint32_t> counts;
+    std::vector<std::vector<uint32_t>> displs;
+    std::vector<size_t> totals;
+    void data_init(int n_procs, int max_count, bool reversed, bool inplace,
+                   bool gaps = false) {
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        counts.resize(n_procs);
+        displs.resize(n_procs);
+        totals.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            counts[r] = (r * 7 + 3) % (max_count + 1);
+        }
+        for (int r = 0; r < n_procs; r++) {
+            displs[r].resize(n_procs);
+            totals[r] = 0;
+            for (int i = 0; i < n_procs; i++) {
+                int p = reversed ? n_procs - 1 - i : i;
+                displs[r][p] = totals[r];
+                totals[r] += counts[p] + (gaps ? (p + r) % 3 : 0);
+            }
+        }
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(counts[r]);
+            for (int i = 0; i < counts[r]; i++) {
+                sbufs[r][i] = r * 1000 + i;
+            }
+            rbufs[r].assign(totals[r] + 1, -1);
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLGATHERV;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.src_counts   = (ucc_count_t *)&counts[r];
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.dst_counts   = (ucc_count_t *)counts.data();
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_displacements =
+                (ucc_aint_t *)displs[r].data();
+            if (inplace) {
+                for (int i = 0; i < counts[r]; i++) {
+                    rbufs[r][displs[r][r] + i] = sbufs[r][i];
+                }
+                args[r].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+            }
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int p = 0; p < n_procs; p++) {
+                for (int i = 0; i < counts[p]; i++) {
+                    EXPECT_EQ(p * 1000 + i, rbufs[r][displs[r][p] + i]);
+                }
+            }
+            EXPECT_EQ(-1, rbufs[r][totals[r]]);
+        }
+    }
+};
+
+UCC_TEST_P(test_allgatherv, single)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    bool      reversed  = std::get<2>(GetParam());
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, reversed, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allgatherv, single_inplace)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    bool      reversed  = std::get<2>(GetParam());
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, reversed, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allgatherv, single_gaps)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    bool      reversed  = std::get<2>(GetParam());
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, reversed, false, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allgatherv, single_gaps_inplace)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    bool      reversed  = std::get<2>(GetParam());
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, reversed, true, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allgatherv,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),     /* team size */
+                       ::testing::Values(0, 1, 5, 10000), /* max count */
+                       ::testing::Bool()));               /* reversed  */
@@ -0,0 +1,329 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+class test_allreduce_data : public ucc::test {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, bool inplace) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            rbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i] = r + i;
+                rbufs[r][i] = inplace ? sbufs[r][i] : -1;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLREDUCE;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].buffer_info.flags = inplace ? UCC_COLL_BUFF_FLAG_IN_PLACE : 0;
+            args[r].reduce.predefined_op = UCC_OP_SUM;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int i = 0; i < count; i++) {
+                EXPECT_EQ(n_procs * (n_procs - 1) / 2 + n_procs * i,
+                          rbufs[r][i]);
+            }
+        }
+    }
+    void run(UccTeam_h team)
+    {
+        UccReq req(team, args);
+        req.start();
+        req.wait();
+        data_validate(team->n_procs);
+    }
+};
+
+/* Parameters: team size, number of elements */
+class test_allreduce : public test_allreduce_data,
+                       public ::testing::WithParamInterface<
+                           std::tuple<int, ucc_count_t>> {
+};
+
+UCC_TEST_P(test_allreduce, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allreduce, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_allreduce, persistent)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, false);
+    for (auto &a : args) {
+        a.buffer_info.flags |= UCC_COLL_BUFF_FLAG_PERSISTENT;
+    }
+    UccReq req(team, args);
+    for (int i = 0; i < 3; i++) {
+        for (auto &rbuf : rbufs) {
+            std::fill(rbuf.begin(), rbuf.end(), -1);
+        }
+        req.start();
+        req.wait();
+        data_validate(team_size);
+    }
+}
+
+UCC_TEST_P(test_allreduce, repost_not_persistent)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    for (auto r : req.reqs) {
+        EXPECT_EQ(UCC_ERR_INVALID_PARAM, ucc_collective_post(r));
+    }
+}
+
+UCC_TEST_P(test_allreduce, init_and_post)
+{
+    int                         team_size = std::get<0>(GetParam());
+    ucc_count_t                 count     = std::get<1>(GetParam());
+    UccTeam_h                   team      =
+        UccJob::getStaticJob()->create_team(team_size);
+    std::vector<ucc_coll_req_h> reqs(team_size);
+    bool                        done      = false;
+    data_init(team_size, count, false);
+    for (int i = 0; i < team_size; i++) {
+        EXPECT_EQ(UCC_OK, ucc_collective_init_and_post(&args[i], &reqs[i],
+                                                       team->procs[i].team));
+    }
+    while (!done) {
+        done = true;
+        for (auto r : reqs) {
+            if (UCC_OK != ucc_collective_test(r)) {
+                done = false;
+            }
+        }
+        team->progress();
+    }
+    for (auto r : reqs) {
+        EXPECT_EQ(UCC_OK, ucc_collective_finalize(r));
+    }
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allreduce,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16), /* team size */
+                       ::testing::Values(1, 3, 1024, 65536))); /* count     */
+
+/* Parameters: team size, number of elements, inplace. Lowered thresholds
+   select the ring with many fragments per block, more than the window. */
+class test_allreduce_ring : public test_allreduce_data,
+                            public ::testing::WithParamInterface<
+                                std::tuple<int, ucc_count_t, bool>> {
+};
+
+UCC_TEST_P(test_allreduce_ring, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccJob      job(team_size, {{"UCC_TL_UCP_ALLREDUCE_RING_THRESH", "0"},
+                                {"UCC_TL_UCP_ALLREDUCE_RING_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_ALLREDUCE_RING_N_FRAGS", "3"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, std::get<2>(GetParam()));
+    run(team);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allreduce_ring,
+    ::testing::Combine(::testing::Values(2, 3, 8), /* team size */
+                       ::testing::Values(8, 1000, 4099), /* count */
+                       ::testing::Bool())); /* inplace */
+
+/* Parameters: team size, number of elements, inplace. Lowered thresholds
+   select the double binary tree with more fragments than the window. */
+class test_allreduce_dbt : public test_allreduce_data,
+                           public ::testing::WithParamInterface<
+                               std::tuple<int, ucc_count_t, bool>> {
+};
+
+UCC_TEST_P(test_allreduce_dbt, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccJob      job(team_size, {{"UCC_TL_UCP_ALLREDUCE_DBT_MIN_TEAM_SIZE", "2"},
+                                {"UCC_TL_UCP_ALLREDUCE_DBT_THRESH", "0"},
+                                {"UCC_TL_UCP_ALLREDUCE_DBT_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_ALLREDUCE_DBT_N_FRAGS", "2"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, std::get<2>(GetParam()));
+    run(team);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allreduce_dbt,
+    ::testing::Combine(::testing::Values(2, 3, 7, 8, 13, 16), /* team size */
+                       ::testing::Values(1, 5, 1000, 4099), /* count */
+                       ::testing::Bool())); /* inplace */
+
+/* Parameters: team size, number of elements, inplace. Lowered thresholds
+   split the allreduce into 64 byte fragments, the count is not a multiple
+   of the fragment, so the last one is short. */
+class test_allreduce_pipelined : public test_allreduce_data,
+                                 public ::testing::WithParamInterface<
+                                     std::tuple<int, ucc_count_t, bool>> {
+};
+
+UCC_TEST_P(test_allreduce_pipelined, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccJob      job(team_size, {{"UCC_TL_UCP_PIPELINE_THRESH", "0"},
+                                {"UCC_TL_UCP_PIPELINE_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_PIPELINE_N_FRAGS", "2"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, std::get<2>(GetParam()));
+    run(team);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allreduce_pipelined,
+    ::testing::Combine(::testing::Values(2, 3, 8), /* team size */
+                       ::testing::Values(17, 1000, 4099), /* count */
+                       ::testing::Bool())); /* inplace */
+
+typedef struct test_allreduce_loc_pair {
+    double  value;
+    int32_t index;
+} test_allreduce_loc_pair_t;
+
+/* Parameters: team size, number of elements, MAXLOC or MINLOC. Rank r
+   contributes the value (r + i) % 3 with index r, so with more than 3 ranks
+   every value is shared by several ranks and the lowest one must win. */
+class test_allreduce_loc : public ucc::test,
+                           public ::testing::WithParamInterface<
+                               std::tuple<int, ucc_count_t,
+                                          ucc_reduction_op_t>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<test_allreduce_loc_pair_t>> sbufs;
+    std::vector<std::vector<test_allreduce_loc_pair_t>> rbufs;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, ucc_reduction_op_t op,
+                   bool inplace) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            rbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i].value = (r + i) % 3;
+                sbufs[r][i].index = r;
+                rbufs[r][i].value = inplace ? sbufs[r][i].value : -1;
+                rbufs[r][i].index = inplace ? sbufs[r][i].index : -1;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLREDUCE;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_FLOAT64_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_FLOAT64_INT32;
+            args[r].buffer_info.flags = inplace ? UCC_COLL_BUFF_FLAG_IN_PLACE : 0;
+            args[r].reduce.predefined_op = op;
+        }
+    }
+    void data_validate(int n_procs, ucc_reduction_op_t op) {
+        for (int i = 0; i < count; i++) {
+            double  value = (i % 3);
+            int32_t index = 0;
+            for (int r = 1; r < n_procs; r++) {
+                if ((UCC_OP_MAXLOC == op) ? ((r + i) % 3 > value)
+                                          : ((r + i) % 3 < value)) {
+                    value = (r + i) % 3;
+                    index = r;
+                }
+            }
+            for (int r = 0; r < n_procs; r++) {
+                EXPECT_EQ(value, rbufs[r][i].value);
+                EXPECT_EQ(index, rbufs[r][i].index);
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_allreduce_loc, single)
+{
+    int                team_size = std::get<0>(GetParam());
+    ucc_count_t        count     = std::get<1>(GetParam());
+    ucc_reduction_op_t op        = std::get<2>(GetParam());
+    UccTeam_h          team      =
+        UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, op, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, op);
+}
+
+UCC_TEST_P(test_allreduce_loc, single_inplace)
+{
+    int                team_size = std::get<0>(GetParam());
+    ucc_count_t        count     = std::get<1>(GetParam());
+    ucc_reduction_op_t op        = std::get<2>(GetParam());
+    UccTeam_h          team      =
+        UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, op, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, op);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allreduce_loc,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),         /* team size */
+                       ::testing::Values(1, 3, 1024, 65536),  /* count     */
+                       ::testing::Values(UCC_OP_MAXLOC,
+                                         UCC_OP_MINLOC)));    /* op        */
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, number of elements per peer */
+class test_alltoall : public ucc::test,
+                      public ::testing::WithParamInterface<
+                          std::tuple<int, ucc_count_t>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count * n_procs);
+            rbufs[r].resize(count * n_procs);
+            /* block p of rank r encodes the (sender, receiver) pair */
+            for (int p = 0; p < n_procs; p++) {
+                for (int i = 0; i < count; i++) {
+                    sbufs[r][p * count + i] = (r * n_procs + p) * count + i;
+                    rbufs[r][p * count + i] = -1;
+                }
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLTOALL;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int p = 0; p < n_procs; p++) {
+                for (int i = 0; i < count; i++) {
+                    EXPECT_EQ((p * n_procs + r) * count + i,
+                              rbufs[r][p * count + i]);
+                }
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_alltoall, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+/* counts from 32 on select pairwise, which keeps its step in the posted
+   counters: every repost must start over from the first step */
+UCC_TEST_P(test_alltoall, persistent)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count);
+    for (auto &a : args) {
+        a.buffer_info.flags |= UCC_COLL_BUFF_FLAG_PERSISTENT;
+    }
+    UccReq req(team, args);
+    for (int i = 0; i < 3; i++) {
+        for (auto &rbuf : rbufs) {
+            std::fill(rbuf.begin(), rbuf.end(), -1);
+        }
+        req.start();
+        req.wait();
+        data_validate(team_size);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_alltoall,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16), /* team size */
+                       ::testing::Values(1, 3, 1024, 65536))); /* count     */
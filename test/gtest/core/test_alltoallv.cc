@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, max number of elements per peer, 64 bit counts
+   and displacements. Rank r sends (r + p) % (max + 1) elements to rank p,
+   so some of the pairs exchange nothing. */
+class test_alltoallv : public ucc::test,
+                       public ::testing::WithParamInterface<
+                           std::tuple<int, int, bool>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    std::vector<std::vector<uint64_t>> scounts, sdispls, rcounts, rdispls;
+    std::vector<std::vector<uint32_t>> scounts32, sdispls32, rcounts32,
+        rdispls32;
+    int max_count;
+    int pair_count(int from, int to) {
+        return (from + to) % (max_count + 1);
+    }
+    void data_init(int n_procs, int _max_count, bool is64) {
+        max_count = _max_count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        scounts.resize(n_procs);
+        sdispls.resize(n_procs);
+        rcounts.resize(n_procs);
+        rdispls.resize(n_procs);
+        scounts32.resize(n_procs);
+        sdispls32.resize(n_procs);
+        rcounts32.resize(n_procs);
+        rdispls32.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            size_t stotal = 0, rtotal = 0;
+            for (int p = 0; p < n_procs; p++) {
+                scounts[r].push_back(pair_count(r, p));
+                sdispls[r].push_back(stotal);
+                rcounts[r].push_back(pair_count(p, r));
+                rdispls[r].push_back(rtotal);
+                stotal += scounts[r][p];
+                rtotal += rcounts[r][p];
+            }
+            scounts32[r].assign(scounts[r].begin(), scounts[r].end());
+            sdispls32[r].assign(sdispls[r].begin(), sdispls[r].end());
+            rcounts32[r].assign(rcounts[r].begin(), rcounts[r].end());
+            rdispls32[r].assign(rdispls[r].begin(), rdispls[r].end());
+            sbufs[r].resize(stotal + 1);
+            rbufs[r].assign(rtotal + 1, -1);
+            for (int p = 0; p < n_procs; p++) {
+                for (int i = 0; i < scounts[r][p]; i++) {
+                    sbufs[r][sdispls[r][p] + i] = (r * n_procs + p) * 1000 + i;
+                }
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO;
+            args[r].coll_type                = UCC_COLL_TYPE_ALLTOALLV;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            if (is64) {
+                args[r].buffer_info.src_counts        = scounts[r].data();
+                args[r].buffer_info.src_displacements = sdispls[r].data();
+                args[r].buffer_info.dst_counts        = rcounts[r].data();
+                args[r].buffer_info.dst_displacements = rdispls[r].data();
+                args[r].buffer_info.flags =
+                    UCC_COLL_BUFF_FLAG_COUNT_64BIT |
+                    UCC_COLL_BUFF_FLAG_DISPLACEMENTS_64BIT;
+            } else {
+                args[r].buffer_info.src_counts =
+                    (ucc_count_t *)scounts32[r].data();
+                args[r].buffer_info.src_displacements =
+                    (ucc_aint_t *)sdispls32[r].data();
+                args[r].buffer_info.dst_counts =
+                    (ucc_count_t *)rcounts32[r].data();
+                args[r].buffer_info.dst_displacements =
+                    (ucc_aint_t *)rdispls32[r].data();
+            }
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int p = 0; p < n_procs; p++) {
+                for (int i = 0; i < rcounts[r][p]; i++) {
+                    EXPECT_EQ((p * n_procs + r) * 1000 + i,
+                              rbufs[r][rdispls[r][p] + i]);
+                }
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_alltoallv, single)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    bool      is64      = std::get<2>(GetParam());
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, is64);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_alltoallv,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16), /* team size */
+                       ::testing::Values(0, 1, 5, 100), /* max count */
+                       ::testing::Bool()));             /* 64 bit    */
@@ -41,3 +41,31 @@ UCC_TEST_F(test_barrier, multiple)
     UccReq::startall(reqs);
     UccReq::waitall(reqs);
 }
+
+/* Parameters: team size. With the default radix 4 team sizes that are
+   powers of the radix run recursive knomial, the rest run dissemination. */
+class test_barrier_algs : public test_barrier,
+                          public ::testing::WithParamInterface<int> {
+};
+
+UCC_TEST_P(test_barrier_algs, single)
+{
+    UccTeam_h team = UccJob::getStaticJob()->create_team(GetParam());
+    UccReq    req(team, &coll);
+    req.start();
+    req.wait();
+}
+
+UCC_TEST_P(test_barrier_algs, repeated)
+{
+    UccTeam_h team = UccJob::getStaticJob()->create_team(GetParam());
+    for (int i = 0; i < 10; i++) {
+        UccReq req(team, &coll);
+        req.start();
+        req.wait();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_barrier_algs,
+    ::testing::Values(2, 3, 4, 5, 7, 8, 13, 16)); /* team size */
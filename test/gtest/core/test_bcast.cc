@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+class test_bcast_data : public ucc::test {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> bufs;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, int root) {
+        count = _count;
+        args.resize(n_procs);
+        bufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            bufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                bufs[r][i] = (r == root) ? root + i : -1;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type                = UCC_COLL_TYPE_BCAST;
+            args[r].root                     = root;
+            args[r].buffer_info.dst_buffer   = bufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+        }
+    }
+    void data_validate(int n_procs, int root) {
+        for (int r = 0; r < n_procs; r++) {
+            for (int i = 0; i < count; i++) {
+                EXPECT_EQ(root + i, bufs[r][i]);
+            }
+        }
+    }
+};
+
+/* Parameters: team size, number of elements, root */
+class test_bcast : public test_bcast_data,
+                   public ::testing::WithParamInterface<
+                       std::tuple<int, ucc_count_t, int>> {
+};
+
+UCC_TEST_P(test_bcast, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, root);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_bcast,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),         /* team size */
+                       ::testing::Values(1, 3, 1024, 100003), /* count     */
+                       ::testing::Values(0, 5)));             /* root      */
+
+/* Parameters: team size, number of elements, root. Lowered thresholds
+   select the chain with more fragments than the window. */
+class test_bcast_chain : public test_bcast_data,
+                         public ::testing::WithParamInterface<
+                             std::tuple<int, ucc_count_t, int>> {
+};
+
+UCC_TEST_P(test_bcast_chain, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccJob      job(team_size, {{"UCC_TL_UCP_BCAST_CHAIN_THRESH", "0"},
+                                {"UCC_TL_UCP_BCAST_CHAIN_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_BCAST_CHAIN_N_FRAGS", "2"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, root);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, root);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_bcast_chain,
+    ::testing::Combine(::testing::Values(2, 3, 8, 16),     /* team size */
+                       ::testing::Values(1, 1000, 4099),  /* count     */
+                       ::testing::Values(0, 5)));         /* root      */
+
+/* Parameters: team size, number of elements, root. Lowered thresholds
+   split the bcast into 64 byte fragments, the count is not a multiple of
+   the fragment, so the last one is short. */
+class test_bcast_pipelined : public test_bcast_data,
+                             public ::testing::WithParamInterface<
+                                 std::tuple<int, ucc_count_t, int>> {
+};
+
+UCC_TEST_P(test_bcast_pipelined, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccJob      job(team_size, {{"UCC_TL_UCP_PIPELINE_THRESH", "0"},
+                                {"UCC_TL_UCP_PIPELINE_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_PIPELINE_N_FRAGS", "2"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, root);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, root);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_bcast_pipelined,
+    ::testing::Combine(::testing::Values(2, 3, 8),          /* team size */
+                       ::testing::Values(17, 1000, 4099),  /* count     */
+                       ::testing::Values(0, 5)));          /* root      */
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, root */
+class test_fanin_fanout : public ucc::test,
+                          public ::testing::WithParamInterface<
+                              std::tuple<int, int>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    void data_init(int n_procs, ucc_coll_type_t coll_type, int root) {
+        args.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask      = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                                UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type = coll_type;
+            args[r].root      = root;
+        }
+    }
+};
+
+UCC_TEST_P(test_fanin_fanout, fanin)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       root      = std::get<1>(GetParam()) % team_size;
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, UCC_COLL_TYPE_FANIN, root);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+}
+
+UCC_TEST_P(test_fanin_fanout, fanout)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       root      = std::get<1>(GetParam()) % team_size;
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, UCC_COLL_TYPE_FANOUT, root);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+}
+
+UCC_TEST_P(test_fanin_fanout, fanin_then_fanout)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       root      = std::get<1>(GetParam()) % team_size;
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    for (int i = 0; i < 3; i++) {
+        data_init(team_size, UCC_COLL_TYPE_FANIN, root);
+        UccReq fanin(team, args);
+        fanin.start();
+        fanin.wait();
+        data_init(team_size, UCC_COLL_TYPE_FANOUT, root);
+        UccReq fanout(team, args);
+        fanout.start();
+        fanout.wait();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_fanin_fanout,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16), /* team size */
+                       ::testing::Values(0, 5)));     /* root      */
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, number of elements per rank, root */
+class test_gather : public ucc::test,
+                    public ::testing::WithParamInterface<
+                        std::tuple<int, ucc_count_t, int>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<int32_t> rbuf;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, int root, bool inplace) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbuf.resize(count * n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i] = r * count + i;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type                = UCC_COLL_TYPE_GATHER;
+            args[r].root                     = root;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            /* dst is significant at root only */
+            args[r].buffer_info.dst_buffer   = nullptr;
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+        }
+        for (int i = 0; i < count * n_procs; i++) {
+            rbuf[i] = -1;
+        }
+        args[root].buffer_info.dst_buffer = rbuf.data();
+        if (inplace) {
+            for (int i = 0; i < count; i++) {
+                rbuf[root * count + i] = sbufs[root][i];
+            }
+            args[root].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int i = 0; i < count * n_procs; i++) {
+            EXPECT_EQ(i, rbuf[i]);
+        }
+    }
+};
+
+UCC_TEST_P(test_gather, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_gather, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_gather,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),        /* team size */
+                       ::testing::Values(1, 3, 1024, 65536), /* count     */
+                       ::testing::Values(0, 5)));            /* root      */
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, max number of elements per rank, root. Rank r
+   contributes (r * 7 + 3) % (max + 1) elements, blocks are placed in
+   reverse rank order with gaps between them. */
+class test_gatherv : public ucc::test,
+                     public ::testing::WithParamInterface<
+                         std::tuple<int, int, int>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<int32_t> rbuf;
+    std::vector<uint32_t> counts, displs;
+    size_t total;
+    void data_init(int n_procs, int max_count, int root, bool inplace) {
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        counts.resize(n_procs);
+        displs.resize(n_procs);
+        total = 0;
+        for (int r = n_procs - 1; r >= 0; r--) {
+            counts[r] = (r * 7 + 3) % (max_count + 1);
+            displs[r] = total;
+            total += counts[r] + 1;
+        }
+        rbuf.assign(total, -1);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(counts[r]);
+            for (int i = 0; i < counts[r]; i++) {
+                sbufs[r][i] = r * 1000 + i;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type                = UCC_COLL_TYPE_GATHERV;
+            args[r].root                     = root;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.src_counts   = (ucc_count_t *)&counts[r];
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+        }
+        /* dst is significant at root only */
+        args[root].buffer_info.dst_buffer        = rbuf.data();
+        args[root].buffer_info.dst_counts        = (ucc_count_t *)counts.data();
+        args[root].buffer_info.dst_displacements = (ucc_aint_t *)displs.data();
+        if (inplace) {
+            for (int i = 0; i < counts[root]; i++) {
+                rbuf[displs[root] + i] = sbufs[root][i];
+            }
+            args[root].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int p = 0; p < n_procs; p++) {
+            for (int i = 0; i < counts[p]; i++) {
+                EXPECT_EQ(p * 1000 + i, rbuf[displs[p] + i]);
+            }
+            EXPECT_EQ(-1, rbuf[displs[p] + counts[p]]);
+        }
+    }
+};
+
+UCC_TEST_P(test_gatherv, single)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    int       root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, root, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_gatherv, single_inplace)
+{
+    int       team_size = std::get<0>(GetParam());
+    int       max_count = std::get<1>(GetParam());
+    int       root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, max_count, root, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_gatherv,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),     /* team size */
+                       ::testing::Values(0, 1, 5, 10000), /* max count */
+                       ::testing::Values(0, 5)));         /* root      */
@@ -63,3 +63,102 @@ UCC_TEST_F(test_mc, init_twice)
 
     ucc_lib_config_release(cfg);
 }
+
+UCC_TEST_F(test_mc, can_memcpy_host_mem)
+{
+    size_t size = 4096;
+    void  *src, *dst;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ASSERT_EQ(UCC_OK, ucc_mc_init());
+    EXPECT_EQ(UCC_OK, ucc_mc_alloc(&src, size, UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(UCC_OK, ucc_mc_alloc(&dst, size, UCC_MEMORY_TYPE_HOST));
+    memset(src, 0xab, size);
+    memset(dst, 0, size);
+    EXPECT_EQ(UCC_OK, ucc_mc_memcpy(dst, src, size, UCC_MEMORY_TYPE_HOST,
+                                    UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(0, memcmp(src, dst, size));
+    EXPECT_EQ(UCC_OK, ucc_mc_free(src, UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(UCC_OK, ucc_mc_free(dst, UCC_MEMORY_TYPE_HOST));
+    ucc_mc_finalize();
+}
+
+UCC_TEST_F(test_mc, can_reduce_multi_host_mem)
+{
+    const size_t count     = 1000;
+    const size_t n_vectors = 3;
+    int32_t     *src1, *src2;
+    size_t       i, j;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ASSERT_EQ(UCC_OK, ucc_mc_init());
+    EXPECT_EQ(UCC_OK, ucc_mc_alloc((void **)&src1, count * sizeof(int32_t),
+                                   UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(UCC_OK,
+              ucc_mc_alloc((void **)&src2, n_vectors * count * sizeof(int32_t),
+                           UCC_MEMORY_TYPE_HOST));
+    for (i = 0; i < count; i++) {
+        src1[i] = i;
+        for (j = 0; j < n_vectors; j++) {
+            src2[j * count + i] = (j + 1) * i;
+        }
+    }
+    /* in place: src1 is the destination */
+    EXPECT_EQ(UCC_OK, ucc_mc_reduce_multi(src1, src2, src1, n_vectors, count,
+                                          count * sizeof(int32_t), UCC_DT_INT32,
+                                          UCC_MEMORY_TYPE_HOST, UCC_OP_SUM));
+    for (i = 0; i < count; i++) {
+        EXPECT_EQ((int32_t)(7 * i), src1[i]);
+    }
+    EXPECT_EQ(UCC_OK, ucc_mc_free(src1, UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(UCC_OK, ucc_mc_free(src2, UCC_MEMORY_TYPE_HOST));
+    ucc_mc_finalize();
+}
+
+UCC_TEST_F(test_mc, can_reduce_loc_host_mem)
+{
+    const size_t count = 5;
+    struct {
+        double  value;
+        int32_t index;
+    } src1[count], src2[count], dst[count];
+    double  v1[count] = {1.0, 3.0, 2.0, 2.0, -1.0};
+    double  v2[count] = {2.0, 1.0, 2.0, 2.0, -1.0};
+    int32_t i1[count] = {0, 0, 5, 1, 3};
+    int32_t i2[count] = {1, 1, 4, 2, 3};
+    size_t  i;
+
+    for (i = 0; i < count; i++) {
+        src1[i].value = v1[i];
+        src1[i].index = i1[i];
+        src2[i].value = v2[i];
+        src2[i].index = i2[i];
+    }
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ASSERT_EQ(UCC_OK, ucc_mc_init());
+    EXPECT_EQ(UCC_OK, ucc_mc_reduce(src1, src2, dst, count,
+                                    UCC_DT_FLOAT64_INT32,
+                                    UCC_MEMORY_TYPE_HOST, UCC_OP_MAXLOC));
+    /* ties are resolved to the lower index */
+    EXPECT_EQ(2.0, dst[0].value);
+    EXPECT_EQ(1, dst[0].index);
+    EXPECT_EQ(3.0, dst[1].value);
+    EXPECT_EQ(0, dst[1].index);
+    EXPECT_EQ(4, dst[2].index);
+    EXPECT_EQ(1, dst[3].index);
+    EXPECT_EQ(3, dst[4].index);
+    EXPECT_EQ(UCC_OK, ucc_mc_reduce(src1, src2, dst, count,
+                                    UCC_DT_FLOAT64_INT32,
+                                    UCC_MEMORY_TYPE_HOST, UCC_OP_MINLOC));
+    EXPECT_EQ(1.0, dst[0].value);
+    EXPECT_EQ(0, dst[0].index);
+    EXPECT_EQ(1.0, dst[1].value);
+    EXPECT_EQ(1, dst[1].index);
+    EXPECT_EQ(4, dst[2].index);
+    EXPECT_EQ(1, dst[3].index);
+    EXPECT_EQ(-1.0, dst[4].value);
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED,
+              ucc_mc_reduce(src1, src2, dst, count, UCC_DT_FLOAT64_INT32,
+                            UCC_MEMORY_TYPE_HOST, UCC_OP_SUM));
+    ucc_mc_finalize();
+}
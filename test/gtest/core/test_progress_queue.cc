@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include <core/ucc_progress_queue.h>
+}
+#include "common/test.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Dummy task: completes after "left" progress calls, flags concurrent
+   progress of the same task. Like the TL tasks it sets the status before
+   it returns, the yield widens that window. */
+typedef struct test_pq_task {
+    ucc_coll_task_t   super;
+    int               left;
+    int               n_completed;
+    std::atomic<int>  in_progress;
+    std::atomic<int> *n_errors;
+    std::atomic<int> *n_done;
+} test_pq_task_t;
+
+static ucc_status_t test_pq_task_progress(ucc_coll_task_t *task)
+{
+    test_pq_task_t *t = ucc_derived_of(task, test_pq_task_t);
+
+    if (t->in_progress.exchange(1)) {
+        (*t->n_errors)++;
+    }
+    if (--t->left <= 0) {
+        t->n_completed++;
+        (*t->n_done)++;
+        t->in_progress = 0;
+        __atomic_store_n(&task->super.status, UCC_OK, __ATOMIC_RELEASE);
+        std::this_thread::yield();
+        return UCC_OK;
+    }
+    t->in_progress = 0;
+    return UCC_INPROGRESS;
+}
+
+/* Parameters: number of producer threads, number of progress threads */
+class test_progress_queue
+    : public ucc::test,
+      public ::testing::WithParamInterface<std::tuple<int, int>> {
+public:
+    static const int             n_tasks = 10000;
+    ucc_progress_queue_t        *pq;
+    std::vector<test_pq_task_t>  tasks;
+    std::atomic<int>             n_errors;
+    std::atomic<int>             n_done;
+    test_progress_queue() : tasks(n_tasks), n_errors(0), n_done(0)
+    {
+        EXPECT_EQ(UCC_OK, ucc_progress_queue_init(&pq, UCC_THREAD_MULTIPLE));
+        for (int i = 0; i < n_tasks; i++) {
+            tasks[i].n_completed = 0;
+            task_init(i);
+        }
+    }
+    void task_init(int i)
+    {
+        test_pq_task_t *t = &tasks[i];
+        EXPECT_EQ(UCC_OK, ucc_coll_task_init(&t->super));
+        t->super.progress     = test_pq_task_progress;
+        t->super.super.status = UCC_INPROGRESS;
+        t->left               = i % 4 + 1;
+        t->in_progress        = 0;
+        t->n_errors           = &n_errors;
+        t->n_done             = &n_done;
+    }
+    ~test_progress_queue()
+    {
+        ucc_progress_queue_finalize(pq);
+    }
+};
+
+UCC_TEST_P(test_progress_queue, concurrent)
+{
+    int                      n_producers = std::get<0>(GetParam());
+    int                      n_consumers = std::get<1>(GetParam());
+    std::atomic<bool>        stop(false);
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < n_consumers; c++) {
+        threads.push_back(std::thread([&]() {
+            while (!stop) {
+                EXPECT_LE(0, ucc_progress_queue(pq));
+            }
+        }));
+    }
+    for (int p = 0; p < n_producers; p++) {
+        threads.push_back(std::thread([&, p]() {
+            for (int i = p; i < n_tasks; i += n_producers) {
+                ucc_progress_enqueue(pq, &tasks[i].super);
+            }
+        }));
+    }
+    for (int p = 0; p < n_producers; p++) {
+        threads[n_consumers + p].join();
+    }
+    while (n_done < n_tasks) {
+        if (0 == n_consumers) {
+            EXPECT_LE(0, ucc_progress_queue(pq));
+        }
+    }
+    stop = true;
+    for (int c = 0; c < n_consumers; c++) {
+        threads[c].join();
+    }
+    EXPECT_EQ(0, n_errors);
+    for (auto &t : tasks) {
+        EXPECT_EQ(1, t.n_completed);
+    }
+}
+
+/* The owner of a task poisons it, as a finalize returning it to the mpool
+   would, and posts it again as soon as it sees the completion */
+UCC_TEST_P(test_progress_queue, reuse_on_completion)
+{
+    const int                n_reused    = 1000;
+    const int                n_rounds    = 5;
+    int                      n_owners    = std::get<0>(GetParam());
+    int                      n_consumers = std::get<1>(GetParam());
+    std::atomic<bool>        stop(false);
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < n_consumers; c++) {
+        threads.push_back(std::thread([&]() {
+            while (!stop) {
+                EXPECT_LE(0, ucc_progress_queue(pq));
+            }
+        }));
+    }
+    for (int p = 0; p < n_owners; p++) {
+        threads.push_back(std::thread([&, p]() {
+            std::vector<int> rounds(n_reused, 0);
+            int              n_left = 0;
+
+            for (int i = p; i < n_reused; i += n_owners) {
+                ucc_progress_enqueue(pq, &tasks[i].super);
+                n_left++;
+            }
+            while (n_left > 0) {
+                if (0 == n_consumers) {
+                    EXPECT_LE(0, ucc_progress_queue(pq));
+                }
+                for (int i = p; i < n_reused; i += n_owners) {
+                    test_pq_task_t *t = &tasks[i];
+                    if (rounds[i] == n_rounds ||
+                        UCC_OK != __atomic_load_n(&t->super.super.status,
+                                                  __ATOMIC_ACQUIRE)) {
+                        continue;
+                    }
+                    ucc_progress_queue_fence(pq);
+                    memset((void *)&t->super.list_elem, 0xff,
+                           sizeof(t->super.list_elem));
+                    memset((void *)&t->super.em, 0xff, sizeof(t->super.em));
+                    t->super.super.status = UCC_OPERATION_INITIALIZED;
+                    if (++rounds[i] == n_rounds) {
+                        n_left--;
+                        continue;
+                    }
+                    task_init(i);
+                    ucc_progress_enqueue(pq, &t->super);
+                }
+            }
+        }));
+    }
+    for (int p = 0; p < n_owners; p++) {
+        threads[n_consumers + p].join();
+    }
+    stop = true;
+    for (int c = 0; c < n_consumers; c++) {
+        threads[c].join();
+    }
+    EXPECT_EQ(0, n_errors);
+    for (int i = 0; i < n_reused; i++) {
+        EXPECT_EQ(n_rounds, tasks[i].n_completed);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_progress_queue,
+    ::testing::Combine(::testing::Values(1, 4), /* producers */
+                       ::testing::Values(0, 1, 4))); /* progress threads */
@@ -0,0 +1,212 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+class test_reduce_data : public ucc::test {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<int32_t> rbuf;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, int root, bool inplace) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbuf.resize(count);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i] = r + i;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS |
+                           UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type                = UCC_COLL_TYPE_REDUCE;
+            args[r].root                     = root;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            /* dst is significant at root only */
+            args[r].buffer_info.dst_buffer   = nullptr;
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].reduce.predefined_op     = UCC_OP_SUM;
+        }
+        for (int i = 0; i < count; i++) {
+            rbuf[i] = inplace ? sbufs[root][i] : -1;
+        }
+        args[root].buffer_info.dst_buffer = rbuf.data();
+        if (inplace) {
+            args[root].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int i = 0; i < count; i++) {
+            EXPECT_EQ(n_procs * (n_procs - 1) / 2 + n_procs * i, rbuf[i]);
+        }
+    }
+};
+
+/* Parameters: team size, number of elements, root */
+class test_reduce : public test_reduce_data,
+                    public ::testing::WithParamInterface<
+                        std::tuple<int, ucc_count_t, int>> {
+};
+
+UCC_TEST_P(test_reduce, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_reduce, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_reduce,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),        /* team size */
+                       ::testing::Values(1, 3, 1024, 65536), /* count     */
+                       ::testing::Values(0, 5)));            /* root      */
+
+/* Parameters: team size, number of elements, root, inplace. Lowered
+   thresholds split the reduce into 64 byte fragments, the count is not a
+   multiple of the fragment, so the last one is short. */
+class test_reduce_pipelined : public test_reduce_data,
+                              public ::testing::WithParamInterface<
+                                  std::tuple<int, ucc_count_t, int, bool>> {
+};
+
+UCC_TEST_P(test_reduce_pipelined, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    int         root      = std::get<2>(GetParam()) % team_size;
+    UccJob      job(team_size, {{"UCC_TL_UCP_PIPELINE_THRESH", "0"},
+                                {"UCC_TL_UCP_PIPELINE_FRAG_SIZE", "64"},
+                                {"UCC_TL_UCP_PIPELINE_N_FRAGS", "2"}});
+    UccTeam_h   team      = job.create_team(team_size);
+    data_init(team_size, count, root, std::get<3>(GetParam()));
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_reduce_pipelined,
+    ::testing::Combine(::testing::Values(2, 3, 8),          /* team size */
+                       ::testing::Values(17, 1000, 4099),  /* count     */
+                       ::testing::Values(0, 5),            /* root      */
+                       ::testing::Bool()));                /* inplace   */
+
+typedef struct test_reduce_loc_pair {
+    double  value;
+    int32_t index;
+} test_reduce_loc_pair_t;
+
+/* Parameters: team size, number of elements, root, MAXLOC or MINLOC.
+   Rank r contributes the value (r + i) % 3 with index r, so with more than
+   3 ranks every value is shared by several ranks and the lowest one must
+   win. */
+class test_reduce_loc : public ucc::test,
+                        public ::testing::WithParamInterface<
+                            std::tuple<int, ucc_count_t, int,
+                                       ucc_reduction_op_t>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<test_reduce_loc_pair_t>> sbufs;
+    std::vector<test_reduce_loc_pair_t> rbuf;
+    ucc_count_t count;
+    void data_init(int n_procs, ucc_count_t _count, int root,
+                   ucc_reduction_op_t op) {
+        count = _count;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbuf.resize(count);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i].value = (r + i) % 3;
+                sbufs[r][i].index = r;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS |
+                           UCC_COLL_ARG_FIELD_ROOT;
+            args[r].coll_type                = UCC_COLL_TYPE_REDUCE;
+            args[r].root                     = root;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            /* dst is significant at root only */
+            args[r].buffer_info.dst_buffer   = nullptr;
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_FLOAT64_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_FLOAT64_INT32;
+            args[r].reduce.predefined_op     = op;
+        }
+        for (int i = 0; i < count; i++) {
+            rbuf[i].value = -1;
+            rbuf[i].index = -1;
+        }
+        args[root].buffer_info.dst_buffer = rbuf.data();
+    }
+    void data_validate(int n_procs, ucc_reduction_op_t op) {
+        for (int i = 0; i < count; i++) {
+            double  value = (i % 3);
+            int32_t index = 0;
+            for (int r = 1; r < n_procs; r++) {
+                if ((UCC_OP_MAXLOC == op) ? ((r + i) % 3 > value)
+                                          : ((r + i) % 3 < value)) {
+                    value = (r + i) % 3;
+                    index = r;
+                }
+            }
+            EXPECT_EQ(value, rbuf[i].value);
+            EXPECT_EQ(index, rbuf[i].index);
+        }
+    }
+};
+
+UCC_TEST_P(test_reduce_loc, single)
+{
+    int                team_size = std::get<0>(GetParam());
+    ucc_count_t        count     = std::get<1>(GetParam());
+    int                root      = std::get<2>(GetParam()) % team_size;
+    ucc_reduction_op_t op        = std::get<3>(GetParam());
+    UccTeam_h          team      =
+        UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, root, op);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size, op);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_reduce_loc,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),        /* team size */
+                       ::testing::Values(1, 3, 1024),        /* count     */
+                       ::testing::Values(0, 5),              /* root      */
+                       ::testing::Values(UCC_OP_MAXLOC,
+                                         UCC_OP_MINLOC)));   /* op        */
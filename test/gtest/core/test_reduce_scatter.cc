@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, number of elements per rank */
+class test_reduce_scatter : public ucc::test,
+                            public ::testing::WithParamInterface<
+                                std::tuple<int, ucc_count_t>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    ucc_count_t count;
+    bool inplace;
+    void data_init(int n_procs, ucc_count_t _count, bool _inplace) {
+        count   = _count;
+        inplace = _inplace;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count * n_procs);
+            for (int i = 0; i < count * n_procs; i++) {
+                sbufs[r][i] = r + i;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS;
+            args[r].coll_type                = UCC_COLL_TYPE_REDUCE_SCATTER;
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].reduce.predefined_op     = UCC_OP_SUM;
+            if (inplace) {
+                /* input is the whole dst, result goes to block "rank" */
+                rbufs[r] = sbufs[r];
+                args[r].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+            } else {
+                rbufs[r].resize(count);
+                args[r].buffer_info.src_buffer = sbufs[r].data();
+            }
+            args[r].buffer_info.dst_buffer = rbufs[r].data();
+        }
+    }
+    void data_validate(int n_procs) {
+        for (int r = 0; r < n_procs; r++) {
+            int32_t *res = rbufs[r].data() + (inplace ? r * count : 0);
+            for (int i = 0; i < count; i++) {
+                EXPECT_EQ(n_procs * (n_procs - 1) / 2 +
+                              n_procs * (r * count + i),
+                          res[i]);
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_reduce_scatter, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_reduce_scatter, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_reduce_scatter,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),         /* team size */
+                       ::testing::Values(1, 3, 1024, 65536))); /* count     */
@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+/* Parameters: team size, number of elements, exclusive scan */
+class test_scan : public ucc::test,
+                  public ::testing::WithParamInterface<
+                      std::tuple<int, ucc_count_t, bool>> {
+public:
+    std::vector<ucc_coll_op_args_t> args;
+    std::vector<std::vector<int32_t>> sbufs;
+    std::vector<std::vector<int32_t>> rbufs;
+    ucc_count_t count;
+    bool exclusive;
+    void data_init(int n_procs, ucc_count_t _count, bool _exclusive,
+                   bool inplace) {
+        count     = _count;
+        exclusive = _exclusive;
+        args.resize(n_procs);
+        sbufs.resize(n_procs);
+        rbufs.resize(n_procs);
+        for (int r = 0; r < n_procs; r++) {
+            sbufs[r].resize(count);
+            rbufs[r].resize(count);
+            for (int i = 0; i < count; i++) {
+                sbufs[r][i] = r + i;
+                rbufs[r][i] = inplace ? sbufs[r][i] : -1;
+            }
+            memset(&args[r], 0, sizeof(args[r]));
+            args[r].mask = UCC_COLL_ARG_FIELD_COLL_TYPE |
+                           UCC_COLL_ARG_FIELD_BUFFER_INFO |
+                           UCC_COLL_ARG_FIELD_PREDEFINED_REDUCTIONS;
+            args[r].coll_type = exclusive ? UCC_COLL_TYPE_EXSCAN
+                                          : UCC_COLL_TYPE_SCAN;
+            args[r].buffer_info.src_buffer   = sbufs[r].data();
+            args[r].buffer_info.dst_buffer   = rbufs[r].data();
+            args[r].buffer_info.src_counts   = &count;
+            args[r].buffer_info.src_datatype = UCC_DT_INT32;
+            args[r].buffer_info.dst_datatype = UCC_DT_INT32;
+            args[r].reduce.predefined_op     = UCC_OP_SUM;
+            if (inplace) {
+                args[r].buffer_info.flags = UCC_COLL_BUFF_FLAG_IN_PLACE;
+            }
+        }
+    }
+    void data_validate(int n_procs) {
+        /* dst of rank 0 is not defined for exscan */
+        for (int r = exclusive ? 1 : 0; r < n_procs; r++) {
+            int n = exclusive ? r : r + 1;
+            for (int i = 0; i < count; i++) {
+                EXPECT_EQ(n * (n - 1) / 2 + n * i, rbufs[r][i]);
+            }
+        }
+    }
+};
+
+UCC_TEST_P(test_scan, single)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    bool        exclusive = std::get<2>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, exclusive, false);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+UCC_TEST_P(test_scan, single_inplace)
+{
+    int         team_size = std::get<0>(GetParam());
+    ucc_count_t count     = std::get<1>(GetParam());
+    bool        exclusive = std::get<2>(GetParam());
+    UccTeam_h   team      = UccJob::getStaticJob()->create_team(team_size);
+    data_init(team_size, count, exclusive, true);
+    UccReq req(team, args);
+    req.start();
+    req.wait();
+    data_validate(team_size);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_scan,
+    ::testing::Combine(::testing::Values(2, 7, 8, 16),        /* team size */
+                       ::testing::Values(1, 3, 1024, 65536), /* count     */
+                       ::testing::Bool()));                  /* exclusive */
@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include <core/ucc_context.h>
+#include <schedule/ucc_schedule.h>
+#include <schedule/ucc_schedule_pipelined.h>
+}
+#include "test_context.h"
+#include <vector>
+
+/* Dummy task: completes after "delay" progress calls, 0 - within post */
+typedef struct test_task {
+    ucc_coll_task_t super;
+    ucc_context_t  *ctx;
+    int             delay;
+    int             left;
+    int             stamp;
+    int            *clock;
+} test_task_t;
+
+static ucc_status_t test_task_progress(ucc_coll_task_t *task)
+{
+    test_task_t *t = ucc_derived_of(task, test_task_t);
+
+    if (--t->left <= 0) {
+        t->stamp           = ++(*t->clock);
+        task->super.status = UCC_OK;
+    }
+    return task->super.status;
+}
+
+static ucc_status_t test_task_post(ucc_coll_task_t *task)
+{
+    test_task_t *t = ucc_derived_of(task, test_task_t);
+
+    t->left            = t->delay;
+    task->super.status = UCC_INPROGRESS;
+    if (0 == t->delay) {
+        t->stamp           = ++(*t->clock);
+        task->super.status = UCC_OK;
+        return UCC_OK;
+    }
+    ucc_progress_enqueue(t->ctx->pq, task);
+    return UCC_OK;
+}
+
+class test_schedule : public test_context {
+public:
+    ucc_context_h            ctx_h;
+    std::vector<test_task_t> tasks;
+    ucc_schedule_t           schedule;
+    int                      clock;
+    test_schedule()
+    {
+        ucc_context_params_t ctx_params;
+        ctx_params.mask     = UCC_CONTEXT_PARAM_FIELD_TYPE;
+        ctx_params.ctx_type = UCC_CONTEXT_EXCLUSIVE;
+        EXPECT_EQ(UCC_OK,
+                  ucc_context_create(lib_h, &ctx_params, ctx_config, &ctx_h));
+        EXPECT_EQ(UCC_OK, ucc_schedule_init(&schedule, ctx_h));
+        clock = 0;
+    }
+    ~test_schedule()
+    {
+        EXPECT_EQ(UCC_OK, ucc_schedule_finalize(&schedule.super));
+        EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+    }
+    void add_tasks(int n)
+    {
+        tasks.resize(n);
+        for (int i = 0; i < n; i++) {
+            test_task_t *t = &tasks[i];
+            EXPECT_EQ(UCC_OK, ucc_coll_task_init(&t->super));
+            t->super.post     = test_task_post;
+            t->super.progress = test_task_progress;
+            t->super.finalize = NULL;
+            t->ctx            = ctx_h;
+            t->delay          = i % 3;
+            t->clock          = &clock;
+            EXPECT_EQ(UCC_OK, ucc_schedule_add_task(&schedule, &t->super));
+        }
+    }
+    void add_dep(int task, int dep)
+    {
+        EXPECT_EQ(UCC_OK, ucc_schedule_add_dep(&schedule, &tasks[task].super,
+                                               &tasks[dep].super));
+    }
+    void run()
+    {
+        ASSERT_EQ(UCC_OK, ucc_schedule_start(&schedule));
+        while (UCC_OK != schedule.super.super.status) {
+            ASSERT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+        }
+        /* drain the completed tasks */
+        ASSERT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    }
+    bool before(int t1, int t2)
+    {
+        return tasks[t1].stamp > 0 && tasks[t1].stamp < tasks[t2].stamp;
+    }
+};
+
+UCC_TEST_F(test_schedule, empty)
+{
+    run();
+}
+
+UCC_TEST_F(test_schedule, chain)
+{
+    const int n = 8;
+
+    add_tasks(n);
+    for (int i = 1; i < n; i++) {
+        add_dep(i, i - 1);
+    }
+    run();
+    for (int i = 1; i < n; i++) {
+        EXPECT_TRUE(before(i - 1, i));
+    }
+}
+
+UCC_TEST_F(test_schedule, diamond)
+{
+    add_tasks(4);
+    add_dep(1, 0);
+    add_dep(2, 0);
+    add_dep(3, 1);
+    add_dep(3, 2);
+    for (int i = 0; i < 2; i++) {
+        run();
+        EXPECT_TRUE(before(0, 1));
+        EXPECT_TRUE(before(0, 2));
+        EXPECT_TRUE(before(1, 3));
+        EXPECT_TRUE(before(2, 3));
+    }
+}
+
+/* Fan-in and fan-out wider than any fixed number of listeners */
+UCC_TEST_F(test_schedule, wide)
+{
+    const int width = 64;
+
+    add_tasks(width + 2);
+    for (int i = 1; i <= width; i++) {
+        add_dep(i, 0);
+        add_dep(width + 1, i);
+    }
+    run();
+    for (int i = 1; i <= width; i++) {
+        EXPECT_TRUE(before(0, i));
+        EXPECT_TRUE(before(i, width + 1));
+    }
+}
+
+static int            pipelined_clock;
+static ucc_context_t *pipelined_ctx;
+
+static ucc_status_t test_frag_finalize(ucc_coll_task_t *task)
+{
+    delete ucc_derived_of(task, test_task_t);
+    return UCC_OK;
+}
+
+static ucc_status_t test_frag_init(ucc_base_coll_op_args_t *coll_args,
+                                   ucc_base_team_t *team,
+                                   ucc_coll_task_t **frag)
+{
+    test_task_t *t = new test_task_t;
+
+    ucc_coll_task_init(&t->super);
+    t->super.post     = test_task_post;
+    t->super.progress = test_task_progress;
+    t->super.finalize = test_frag_finalize;
+    t->ctx            = pipelined_ctx;
+    t->delay          = coll_args->args.buffer_info.src_counts[0] % 3;
+    t->clock          = &pipelined_clock;
+    *frag             = &t->super;
+    return UCC_OK;
+}
+
+/* marks the elements of the fragment in the user buffer */
+static ucc_status_t test_frag_setup(ucc_schedule_pipelined_t *schedule,
+                                    ucc_coll_task_t *frag, int frag_num)
+{
+    int   *buf    = (int *)schedule->args.buffer_info.dst_buffer;
+    size_t offset = ucc_schedule_pipelined_frag_offset(schedule, frag_num);
+    size_t count  = (frag_num == schedule->n_frags_total - 1)
+                        ? schedule->last_frag_count
+                        : schedule->frag_count;
+
+    for (size_t i = 0; i < count; i++) {
+        buf[offset + i]++;
+    }
+    return UCC_OK;
+}
+
+UCC_TEST_F(test_schedule, pipelined)
+{
+    const int                sizes[] = {1, 7, 8, 100};
+    ucc_schedule_pipelined_t sp;
+    ucc_base_coll_op_args_t  args;
+    ucc_count_t              count;
+    std::vector<int>         buf;
+
+    pipelined_ctx = ctx_h;
+    for (int n_frags = 1; n_frags < 4; n_frags++) {
+        for (int c = 0; c < 4; c++) {
+            count = sizes[c];
+            buf.assign(count, 0);
+            memset(&args, 0, sizeof(args));
+            args.args.coll_type                = UCC_COLL_TYPE_BCAST;
+            args.args.buffer_info.dst_buffer   = buf.data();
+            args.args.buffer_info.src_counts   = &count;
+            args.args.buffer_info.src_datatype = UCC_DT_INT32;
+            ASSERT_EQ(UCC_OK, ucc_schedule_pipelined_init(
+                                  &args, NULL, test_frag_init,
+                                  test_frag_setup, 3 * sizeof(int), n_frags,
+                                  ctx_h, &sp));
+            EXPECT_EQ((count + 2) / 3, sp.n_frags_total);
+            for (int rep = 0; rep < 2; rep++) {
+                ASSERT_EQ(UCC_OK, sp.super.super.post(&sp.super.super));
+                while (UCC_OK != sp.super.super.super.status) {
+                    ASSERT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+                }
+                ASSERT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+            }
+            /* every element is covered by exactly one fragment */
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(2, buf[i]);
+            }
+            EXPECT_EQ(UCC_OK, sp.super.super.finalize(&sp.super.super));
+        }
+    }
+}